@@ -1,4 +1,4 @@
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -9,13 +9,20 @@ CONFIG += c++17
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    ai/AIScheduler.cpp \
+    ai/CooperativePlanner.cpp \
     ai/EnemyAI.cpp \
+    ai/EnemyCommander.cpp \
     ai/MovementController.cpp \
+    ai/ReservationTable.cpp \
     ai/ShootingController.cpp \
+    ai/SimState.cpp \
+    ai/ThreatMap.cpp \
     ai/pathfinder.cpp \
     core/Game.cpp \
     core/GameLoop.cpp \
     core/GameRules.cpp \
+    core/SessionRecording.cpp \
     core/GameState.cpp \
     gameplay/Bullet.cpp \
     gameplay/Bonus.cpp \
@@ -34,8 +41,19 @@ SOURCES += \
     rendering/Animation.cpp \
     rendering/Camera.cpp \
     rendering/HudItem.cpp \
+    rendering/HudPainter.cpp \
+    rendering/DrawBatchItem.cpp \
+    rendering/DrawListPainter.cpp \
+    rendering/FrameExporter.cpp \
     rendering/EditorOverlayItem.cpp \
+    rendering/FrameWriter.cpp \
+    rendering/ImageRenderBackend.cpp \
+    rendering/OffscreenRenderer.cpp \
+    rendering/RasterRenderBackend.cpp \
+    rendering/RenderBackend.cpp \
+    rendering/RenderLayout.cpp \
     rendering/Renderer.cpp \
+    rendering/SceneRenderBackend.cpp \
     rendering/SpriteManager.cpp \
     systems/CollisionSystem.cpp \
     systems/InputSystem.cpp \
@@ -43,22 +61,38 @@ SOURCES += \
     systems/PhysicsSystem.cpp \
     systems/SoundSystem.cpp \
     world/Base.cpp \
+    world/BinaryLevelCodec.cpp \
+    world/LevelGenerator.cpp \
+    world/LevelIndex.cpp \
     world/LevelLoader.cpp \
+    world/LevelParser.cpp \
+    world/LevelPreloader.cpp \
     world/Map.cpp \
+    world/MapChunkStore.cpp \
+    world/OccupancyGrid.cpp \
     world/Tile.cpp \
+    world/WalkableRegions.cpp \
     world/Wall.cpp \
     view/GridObject.cpp \
     view/agentitem.cpp \
     view/worldview.cpp
 
 HEADERS += \
+    ai/AIContext.h \
+    ai/AIScheduler.h \
+    ai/CooperativePlanner.h \
     ai/EnemyAI.h \
+    ai/EnemyCommander.h \
     ai/MovementController.h \
+    ai/ReservationTable.h \
     ai/ShootingController.h \
+    ai/SimState.h \
+    ai/ThreatMap.h \
     ai/pathfinder.h \
     core/Game.h \
     core/GameLoop.h \
     core/GameRules.h \
+    core/SessionRecording.h \
     core/GameState.h \
     enums/enums.h \
     gameplay/Bullet.h \
@@ -79,8 +113,19 @@ HEADERS += \
     rendering/Animation.h \
     rendering/Camera.h \
     rendering/HudItem.h \
+    rendering/HudPainter.h \
+    rendering/DrawBatchItem.h \
+    rendering/DrawListPainter.h \
+    rendering/FrameExporter.h \
     rendering/EditorOverlayItem.h \
+    rendering/FrameWriter.h \
+    rendering/ImageRenderBackend.h \
+    rendering/OffscreenRenderer.h \
+    rendering/RasterRenderBackend.h \
+    rendering/RenderBackend.h \
+    rendering/RenderLayout.h \
     rendering/Renderer.h \
+    rendering/SceneRenderBackend.h \
     rendering/SpriteManager.h \
     systems/CollisionSystem.h \
     systems/InputSystem.h \
@@ -88,9 +133,17 @@ HEADERS += \
     systems/PhysicsSystem.h \
     systems/SoundSystem.h \
     world/Base.h \
+    world/BinaryLevelCodec.h \
+    world/LevelGenerator.h \
+    world/LevelIndex.h \
     world/LevelLoader.h \
+    world/LevelParser.h \
+    world/LevelPreloader.h \
     world/Map.h \
+    world/MapChunkStore.h \
+    world/OccupancyGrid.h \
     world/Tile.h \
+    world/WalkableRegions.h \
     world/Wall.h \
     view/GridObject.h \
     view/agentitem.h \
@@ -1,5 +1,6 @@
 #include "LevelEditor.h"
 
+#include <QDebug>
 #include <QFile>
 #include <QFileDialog>
 #include <QGraphicsView>
@@ -9,35 +10,25 @@
 #include <QPoint>
 #include <QPointF>
 #include <QSize>
-#include <QRegularExpression>
 #include <QStringList>
 #include <QTextStream>
 #include <QtGlobal>
 #include <Qt>
 #include <algorithm>
 #include <array>
+#include <cmath>
 
 #include "core/Game.h"
 #include "core/GameState.h"
+#include "rendering/Camera.h"
+#include "rendering/RenderLayout.h"
+#include "world/LevelIndex.h"
+#include "world/LevelParser.h"
 #include "world/Map.h"
 #include "world/Tile.h"
+#include "world/WalkableRegions.h"
 
 namespace {
-Tile tileForType(TileType type)
-{
-    switch (type) {
-    case TileType::Empty: return TileFactory::empty();
-    case TileType::Brick: return TileFactory::brick();
-    case TileType::Steel: return TileFactory::steel();
-    case TileType::Forest: return TileFactory::forest();
-    case TileType::Water: return TileFactory::water();
-    case TileType::Ice: return TileFactory::ice();
-    case TileType::Base: return TileFactory::base();
-    }
-
-    Q_UNREACHABLE();
-}
-
 QPoint defaultPlayerSpawn(const QSize& size, const QPoint& baseCell)
 {
     const QPoint leftOfBase(baseCell.x() - 2, baseCell.y());
@@ -79,6 +70,16 @@ void LevelEditor::setView(QGraphicsView* view)
     m_view = view;
 }
 
+void LevelEditor::setLayout(const RenderLayout* layout)
+{
+    m_layout = layout;
+}
+
+void LevelEditor::setCamera(const Camera* camera)
+{
+    m_camera = camera;
+}
+
 TileType LevelEditor::selectedTile() const
 {
     return m_selectedType;
@@ -180,7 +181,7 @@ void LevelEditor::placeTile(const QPoint& cell, TileType type)
     if (existingTile.type == TileType::Base || type == TileType::Base)
         return;
 
-    map->setTile(cell, tileForType(type));
+    map->setTile(cell, TileFactory::forType(type));
 }
 
 bool LevelEditor::isProtectedCell(const QPoint& cell) const
@@ -232,6 +233,17 @@ std::optional<QPoint> LevelEditor::sceneToCell(const QPointF& scenePos) const
     if (!map || !m_view || !m_view->viewport())
         return std::nullopt;
 
+    if (m_layout && m_layout->isValid()) {
+        // Сцена — у пікселях вікна, а поле — у пікселях кадру, меншого в pixelScale разів.
+        const QPointF framePos = scenePos / m_layout->pixelScale();
+        const QPointF tile = m_camera ? m_camera->toTile(framePos)
+                                      : (framePos - m_layout->mapOffset()) / m_layout->tileSize();
+        const QPoint cell(static_cast<int>(std::floor(tile.x())), static_cast<int>(std::floor(tile.y())));
+        if (!map->isInside(cell))
+            return std::nullopt;
+        return cell;
+    }
+
     const QSize viewportSize = m_view->viewport()->size();
     const QSize mapSize = map->size();
     if (viewportSize.isEmpty() || mapSize.isEmpty())
@@ -330,6 +342,10 @@ bool LevelEditor::exportTiles(const QString& filePath) const
         stream << "\n";
     }
 
+    warnUnreachableSpawns(*map, filePath);
+
+    // Рівень у каталозі карт міг змінитися на місці — індекс перебудується при наступному зверненні.
+    LevelIndex::instance().invalidate();
     return true;
 }
 
@@ -339,97 +355,48 @@ bool LevelEditor::importTiles(const QString& filePath)
     if (!map)
         return false;
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    LevelFileBuffer buffer;
+    if (!buffer.open(filePath))
         return false;
 
-    QTextStream stream(&file);
-    QVector<QVector<int>> rows;
-    QSize declaredSize = map->size();
-    bool sizeParsed = false;
-    int lineIndex = 0;
-
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QString trimmed = line.trimmed();
-        if (trimmed.isEmpty()) {
-            ++lineIndex;
-            continue;
-        }
-
-        const QStringList parts = trimmed.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-        if (!sizeParsed && parts.size() >= 2) {
-            bool okWidth = false;
-            bool okHeight = false;
-            const int width = parts.at(0).toInt(&okWidth);
-            const int height = parts.at(1).toInt(&okHeight);
-            if (okWidth && okHeight && width > 0 && height > 0) {
-                declaredSize = QSize(width, height);
-                sizeParsed = true;
-                ++lineIndex;
-                continue;
-            }
-        }
-
-        QVector<int> row;
-        row.reserve(parts.size());
-        for (const QString& part : parts) {
-            bool ok = false;
-            const int value = part.toInt(&ok);
-            if (!ok)
-                continue;
-            row.append(value);
-        }
-        if (!row.isEmpty())
-            rows.append(std::move(row));
-
-        ++lineIndex;
+    // Спершу перевіряємо весь файл, щоби помилка в середині не лишила карту наполовину зміненою.
+    const NumericLevelParser::Result check = NumericLevelParser::parse(buffer.data(), [](int, int, int) {});
+    if (check.error.isValid()) {
+        qWarning() << "LevelEditor:" << filePath << check.error.toString();
+        return false;
     }
 
-    applyTileData(rows, declaredSize);
+    clearEditableCells(*map);
+    NumericLevelParser::parse(buffer.data(), [this, map](int x, int y, int code) {
+        applyTileCode(*map, QPoint(x, y), code);
+    });
+    restoreProtectedCells(*map);
     return true;
 }
 
-void LevelEditor::applyTileData(const QVector<QVector<int>>& rows, const QSize& declaredSize)
+void LevelEditor::clearEditableCells(Map& map) const
 {
-    Map* map = currentMap();
-    if (!map)
-        return;
-
-    Q_UNUSED(declaredSize);
-
-    const QSize mapSize = map->size();
-    const int width = mapSize.width();
-    const int height = mapSize.height();
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
+    const QSize mapSize = map.size();
+    for (int y = 0; y < mapSize.height(); ++y) {
+        for (int x = 0; x < mapSize.width(); ++x) {
             const QPoint cell(x, y);
             if (isProtectedCell(cell))
                 continue;
-            map->setTile(cell, TileFactory::empty());
+            map.setTile(cell, TileFactory::empty());
         }
     }
+}
 
-    const int appliedHeight = std::min(height, static_cast<int>(rows.size()));
-    for (int y = 0; y < appliedHeight; ++y) {
-        const QVector<int>& row = rows.at(y);
-        const int appliedWidth = std::min(width, static_cast<int>(row.size()));
-        for (int x = 0; x < appliedWidth; ++x) {
-            const QPoint cell(x, y);
-            if (isProtectedCell(cell))
-                continue;
-
-            const int code = row.at(x);
-            const std::optional<TileType> type = tileTypeFromCode(code);
-            if (!type.has_value() || *type == TileType::Base)
-                continue;
+void LevelEditor::applyTileCode(Map& map, const QPoint& cell, int code) const
+{
+    if (!map.isInside(cell) || isProtectedCell(cell))
+        return;
 
-            map->setTile(cell, tileForType(*type));
-        }
-    }
+    const std::optional<TileType> type = tileTypeFromCode(code);
+    if (!type.has_value() || *type == TileType::Base || *type == TileType::Empty)
+        return;
 
-    restoreProtectedCells(*map);
+    map.setTile(cell, TileFactory::forType(*type));
 }
 
 void LevelEditor::restoreProtectedCells(Map& map) const
@@ -463,6 +430,38 @@ void LevelEditor::restoreProtectedCells(Map& map) const
     }
 }
 
+void LevelEditor::warnUnreachableSpawns(const Map& map, const QString& filePath) const
+{
+    const QPoint baseCell = m_game ? m_game->rules().baseCell() : QPoint();
+    if (!map.isInside(baseCell))
+        return;
+
+    // Ті самі спавни, що їх захищає restoreProtectedCells: перший вільний кандидат гравця і три ворожі.
+    const QSize mapSize = map.size();
+    const QPoint leftOfBase(baseCell.x() - 1, baseCell.y());
+    const QPoint bottomCenter(std::clamp(mapSize.width() / 2, 0, mapSize.width() - 1),
+                              std::clamp(mapSize.height() - 2, 0, mapSize.height() - 1));
+    const std::array<QPoint, 3> playerCandidates = {defaultPlayerSpawn(mapSize, baseCell), leftOfBase, bottomCenter};
+    QVector<QPoint> spawns;
+    for (const QPoint& candidate : playerCandidates) {
+        if (map.isInside(candidate) && map.tile(candidate).type != TileType::Base) {
+            spawns.append(candidate);
+            break;
+        }
+    }
+    for (const QPoint& spawn : defaultEnemySpawns(mapSize)) {
+        if (map.isInside(spawn) && map.tile(spawn).type != TileType::Base)
+            spawns.append(spawn);
+    }
+
+    // Збереження не блокуємо: недобудований рівень теж варто зберегти, але автор має знати.
+    const WalkableRegions& regions = map.regions();
+    for (const QPoint& spawn : std::as_const(spawns)) {
+        if (!regions.reachesCell(spawn, baseCell))
+            qWarning() << "LevelEditor:" << filePath << "spawn" << spawn << "cannot reach the base";
+    }
+}
+
 QVector<QVector<int>> LevelEditor::buildTileMatrix() const
 {
     QVector<QVector<int>> rows;
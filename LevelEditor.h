@@ -6,8 +6,10 @@
 #include <optional>
 #include <QString>
 
+class Camera;
 class Game;
 class Map;
+class RenderLayout;
 class QGraphicsView;
 class QKeyEvent;
 class QMouseEvent;
@@ -27,6 +29,10 @@ public:
 
     void setGame(Game* game);
     void setView(QGraphicsView* view);
+    // Геометрія й камера Renderer'а: з ними клік переводиться в клітинку з урахуванням
+    // прокрутки, масштабу й збільшення кадру низької роздільності.
+    void setLayout(const RenderLayout* layout);
+    void setCamera(const Camera* camera);
 
     TileType selectedTile() const;
     void setSelectedTile(TileType type);
@@ -46,14 +52,19 @@ private:
     bool loadMapFromFile();
     bool exportTiles(const QString& filePath) const;
     bool importTiles(const QString& filePath);
-    void applyTileData(const QVector<QVector<int>>& rows, const QSize& declaredSize);
+    void clearEditableCells(Map& map) const;
+    void applyTileCode(Map& map, const QPoint& cell, int code) const;
     void restoreProtectedCells(Map& map) const;
+    // Попереджає про спавни, з яких не під'їхати до бази (за Map::regions()).
+    void warnUnreachableSpawns(const Map& map, const QString& filePath) const;
     QVector<QVector<int>> buildTileMatrix() const;
     int tileCode(TileType type) const;
     static std::optional<TileType> tileTypeFromCode(int code);
 
     Game* m_game = nullptr;
     QGraphicsView* m_view = nullptr;
+    const RenderLayout* m_layout = nullptr;
+    const Camera* m_camera = nullptr;
     TileType m_selectedType;
 };
 
@@ -0,0 +1,32 @@
+#ifndef AICONTEXT_H
+#define AICONTEXT_H
+
+#include <QPoint>
+#include <optional>
+
+#include "ai/SimState.h"
+
+class CooperativePlanner;
+class Map;
+class OccupancyGrid;
+class ThreatMap;
+
+/*
+ * AIContext — знімок світу на поточний тік, спільний для всіх агентів.
+ * Game заповнює його один раз перед запуском AIScheduler, тож контролери
+ * не звертаються до Game напряму і не повторюють однакові запити.
+ */
+struct AIContext
+{
+    const Map* map = nullptr;
+    std::optional<QPoint> playerCell;
+    std::optional<QPoint> baseCell;
+    const ThreatMap* threats = nullptr;
+    const OccupancyGrid* occupancy = nullptr;
+    // Єдиний змінний член: агенти по черзі резервують свої шляхи.
+    CooperativePlanner* planner = nullptr;
+    // Наказ EnemyCommander; порожній — командир вимкнений, вороги їдуть до бази.
+    std::optional<CommanderOrder> order;
+};
+
+#endif // AICONTEXT_H
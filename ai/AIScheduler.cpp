@@ -0,0 +1,88 @@
+#include "ai/AIScheduler.h"
+
+#include <QElapsedTimer>
+
+#include "ai/AIContext.h"
+#include "gameplay/EnemyTank.h"
+
+void AIScheduler::addAgent(EnemyTank* tank)
+{
+    if (!tank)
+        return;
+
+    for (const Agent& agent : m_agents) {
+        if (agent.tank == tank)
+            return;
+    }
+
+    Agent agent;
+    agent.tank = tank;
+    m_agents.append(agent);
+}
+
+void AIScheduler::removeAgent(const EnemyTank* tank)
+{
+    for (qsizetype i = 0; i < m_agents.size(); ++i) {
+        if (m_agents.at(i).tank != tank)
+            continue;
+
+        m_agents.removeAt(i);
+        // курсор вказує на наступного агента в черзі — зсуваємо його разом із хвостом
+        if (i < m_cursor)
+            --m_cursor;
+        if (m_cursor >= m_agents.size())
+            m_cursor = 0;
+        return;
+    }
+}
+
+void AIScheduler::clear()
+{
+    m_agents.clear();
+    m_cursor = 0;
+    m_lastProcessed = 0;
+    m_lastElapsedUs = 0;
+}
+
+void AIScheduler::update(const AIContext& context, int deltaMs)
+{
+    m_lastProcessed = 0;
+    m_lastElapsedUs = 0;
+
+    if (m_agents.isEmpty())
+        return;
+
+    // Накопичення часу дешеве, тож виконуємо його для всіх агентів кожного тіку:
+    // пропущений агент отримає реальний проміжок часу, а не фіксовані 16 мс.
+    for (Agent& agent : m_agents) {
+        const EnemyTank* tank = agent.tank;
+        if (!tank || tank->isDestroyed() || tank->isFrozen()) {
+            agent.pendingMs = 0;
+            continue;
+        }
+        agent.pendingMs += deltaMs;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 budgetNs = static_cast<qint64>(m_budgetUs) * 1000;
+    const qsizetype count = m_agents.size();
+
+    for (qsizetype visited = 0; visited < count; ++visited) {
+        // принаймні один агент обробляється за тік, навіть з нульовим бюджетом
+        if (m_budgetUs != kUnlimitedBudget && m_lastProcessed > 0 && timer.nsecsElapsed() >= budgetNs)
+            break;
+
+        Agent& agent = m_agents[m_cursor];
+        m_cursor = (m_cursor + 1) % count;
+
+        if (agent.pendingMs <= 0 || !agent.tank)
+            continue;
+
+        agent.ai.tick(*agent.tank, context, agent.pendingMs);
+        agent.pendingMs = 0;
+        ++m_lastProcessed;
+    }
+
+    m_lastElapsedUs = timer.nsecsElapsed() / 1000;
+}
@@ -0,0 +1,55 @@
+#ifndef AISCHEDULER_H
+#define AISCHEDULER_H
+
+#include <QVector>
+#include <QtGlobal>
+
+#include "ai/EnemyAI.h"
+
+class EnemyTank;
+struct AIContext;
+
+/*
+ * AIScheduler володіє станом контролерів кожного ворога та розподіляє
+ * дорогі рішення (вибір напрямку, постріл) по кадрах за принципом round-robin.
+ * За один тік обробляється стільки агентів, скільки вміщується в бюджет
+ * у мікросекундах; решта продовжує рух за останнім рішенням і отримає
+ * накопичений час при наступному зверненні. Дешеве кермування
+ * (крок, обхід перешкоди) виконує сам EnemyTank кожного тіку.
+ */
+class AIScheduler
+{
+public:
+    static constexpr int kDefaultBudgetUs = 500;
+    // Кожен агент обробляється кожного тіку: порядок рішень не залежить від швидкості машини.
+    static constexpr int kUnlimitedBudget = -1;
+
+    void addAgent(EnemyTank* tank);
+    void removeAgent(const EnemyTank* tank);
+    void clear();
+
+    void setBudgetUs(int budgetUs) { m_budgetUs = budgetUs < 0 ? kUnlimitedBudget : budgetUs; }
+    int budgetUs() const { return m_budgetUs; }
+
+    void update(const AIContext& context, int deltaMs);
+
+    int agentCount() const { return static_cast<int>(m_agents.size()); }
+    int lastProcessedCount() const { return m_lastProcessed; }
+    qint64 lastElapsedUs() const { return m_lastElapsedUs; }
+
+private:
+    struct Agent
+    {
+        EnemyTank* tank = nullptr;
+        EnemyAI ai;
+        int pendingMs = 0;
+    };
+
+    QVector<Agent> m_agents;
+    qsizetype m_cursor = 0;
+    int m_budgetUs = kDefaultBudgetUs;
+    int m_lastProcessed = 0;
+    qint64 m_lastElapsedUs = 0;
+};
+
+#endif // AISCHEDULER_H
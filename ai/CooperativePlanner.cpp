@@ -0,0 +1,348 @@
+#include "ai/CooperativePlanner.h"
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "gameplay/EnemyTank.h"
+#include "world/Map.h"
+#include "world/OccupancyGrid.h"
+#include "world/Tile.h"
+
+namespace {
+constexpr int kUnreachable = std::numeric_limits<int>::max() / 4;
+constexpr int kWalkCost = 1;
+// Цеглу ворог прострілює по дорозі, тож вона лише дорожча, а не глуха.
+constexpr int kBrickCost = 3;
+constexpr int kSide = 2 * CooperativePlanner::kWindow + 1;
+constexpr int kLayer = kSide * kSide;
+constexpr int kStateCount = kLayer * (CooperativePlanner::kWindow + 1);
+
+// Покоління поля йдуть у m_fieldState як 2·g і 2·g+1, тож мусять поміщатися в половину quint32.
+constexpr quint32 kMaxGeneration = 0x7fffffff;
+
+const QPoint kMoves[] = {QPoint(0, -1), QPoint(0, 1), QPoint(-1, 0), QPoint(1, 0), QPoint(0, 0)};
+
+// Вартість входу в клітинку для поля відстаней; -1 — непрохідна й непробивна.
+int enterCost(const Map& map, const QPoint& cell)
+{
+    if (map.isWalkable(cell))
+        return kWalkCost;
+    return map.tile(cell).type == TileType::Brick ? kBrickCost : -1;
+}
+
+std::optional<Direction> directionForDelta(const QPoint& delta)
+{
+    if (delta == QPoint(0, -1))
+        return Direction::Up;
+    if (delta == QPoint(0, 1))
+        return Direction::Down;
+    if (delta == QPoint(-1, 0))
+        return Direction::Left;
+    if (delta == QPoint(1, 0))
+        return Direction::Right;
+    return std::nullopt;
+}
+} // namespace
+
+void CooperativePlanner::advance(int deltaMs)
+{
+    m_clockMs += qMax(0, deltaMs);
+}
+
+void CooperativePlanner::clear()
+{
+    m_reservations.clear();
+    m_clockMs = 0;
+    m_fieldMap = nullptr;
+    m_fieldEnabled = false;
+    m_distance.clear();
+    m_fieldState.clear();
+    m_fieldOpen = {};
+    m_lastExpansions = 0;
+}
+
+void CooperativePlanner::releaseAgent(const EnemyTank* agent)
+{
+    m_reservations.releaseAgent(agent);
+}
+
+CooperativePlanner::Plan CooperativePlanner::planStep(const EnemyTank& tank, const QPoint& start, const QPoint& goal,
+                                                      const Map& map, const OccupancyGrid* occupancy,
+                                                      const std::optional<QPoint>& target)
+{
+    Plan plan;
+    m_lastExpansions = 0;
+    m_reservations.releaseAgent(&tank);
+
+    ensureDistanceField(goal, map);
+    const auto heuristic = [&](const QPoint& cell) {
+        const int distance = distanceAt(cell, map);
+        if (distance >= kUnreachable || !target.has_value())
+            return distance;
+        return (cell - *target).manhattanLength() * kWalkCost;
+    };
+    const int startH = heuristic(start);
+    if (startH >= kUnreachable)
+        return plan;
+
+    if (m_stamp.size() != kStateCount) {
+        m_stamp.fill(0, kStateCount);
+        m_parent.resize(kStateCount);
+    }
+    if (++m_currentStamp == 0) {
+        m_stamp.fill(0);
+        m_currentStamp = 1;
+    }
+
+    const QPoint origin = start - QPoint(kWindow, kWindow);
+    const auto indexOf = [&](const QPoint& cell, int k) {
+        const QPoint local = cell - origin;
+        return (k * kSide + local.y()) * kSide + local.x();
+    };
+    const auto cellOf = [&](int index) {
+        return origin + QPoint(index % kSide, (index / kSide) % kSide);
+    };
+
+    const auto worse = [](const Node& lhs, const Node& rhs) {
+        if (lhs.f != rhs.f)
+            return lhs.f > rhs.f;
+        return lhs.h > rhs.h;
+    };
+    std::priority_queue<Node, std::vector<Node>, decltype(worse)> open(worse);
+
+    const int startIndex = indexOf(start, 0);
+    m_stamp[startIndex] = m_currentStamp;
+    m_parent[startIndex] = -1;
+    open.push({startH, startH, startIndex});
+
+    // Якщо ліміт розкриттів вичерпано, йдемо до найближчого до цілі стану.
+    int resultIndex = -1;
+    Node best = open.top();
+    while (!open.empty() && m_lastExpansions < kMaxExpansions) {
+        const Node node = open.top();
+        open.pop();
+        ++m_lastExpansions;
+
+        const int k = node.index / kLayer;
+        if (node.h <= kWalkCost || k == kWindow) {
+            resultIndex = node.index;
+            break;
+        }
+        if (node.h < best.h || (node.h == best.h && node.index / kLayer > best.index / kLayer))
+            best = node;
+
+        const QPoint cell = cellOf(node.index);
+        const qint64 stepFrom = stepAt(tank, k);
+        const qint64 stepTo = stepAt(tank, k + 1);
+        for (const QPoint& move : kMoves) {
+            const QPoint next = cell + move;
+            const bool waiting = move.isNull();
+            if (!waiting) {
+                if (!map.isWalkable(next))
+                    continue;
+                // Фактично зайняті клітинки (гравець, ворог без плану) блокують лише перший крок.
+                if (k == 0 && occupancy && !occupancy->isFreeFor(next, &tank))
+                    continue;
+                if (m_reservations.isSwapConflict(cell, next, stepFrom, &tank))
+                    continue;
+            }
+            if (m_reservations.isReservedByOther(next, stepTo, &tank))
+                continue;
+
+            const int h = heuristic(next);
+            if (h >= kUnreachable)
+                continue;
+
+            const int nextIndex = indexOf(next, k + 1);
+            if (m_stamp.at(nextIndex) == m_currentStamp)
+                continue;
+
+            m_stamp[nextIndex] = m_currentStamp;
+            m_parent[nextIndex] = node.index;
+            open.push({k + 1 + h, h, nextIndex});
+        }
+    }
+
+    if (resultIndex < 0)
+        resultIndex = best.index;
+
+    // Відновлюємо шлях від кінця вікна до старту і резервуємо його.
+    int firstMoveIndex = resultIndex;
+    for (int index = resultIndex; index >= 0; index = m_parent.at(index)) {
+        m_reservations.reserve(cellOf(index), stepAt(tank, index / kLayer), &tank);
+        if (m_parent.at(index) >= 0)
+            firstMoveIndex = index;
+    }
+
+    plan.found = true;
+    if (firstMoveIndex != startIndex)
+        plan.direction = directionForDelta(cellOf(firstMoveIndex) - start);
+    return plan;
+}
+
+void CooperativePlanner::ensureDistanceField(const QPoint& goal, const Map& map)
+{
+    m_fieldBudget = kMaxFieldExpansions;
+    const bool sameField = m_fieldMap == &map && m_fieldGoal == goal && m_fieldSize == map.size();
+    if (sameField && m_fieldRevision == map.revision()) {
+        drainRepairs(map);
+        return;
+    }
+
+    // Потокова карта: поле прочитало б кожен чанк файлу і тримало б W·H відстаней,
+    // тож за межами вікна оцінкою лишається манхеттенська відстань до цілі.
+    if (map.isStreamed()) {
+        m_fieldMap = &map;
+        m_fieldRevision = map.revision();
+        m_fieldGoal = goal;
+        m_fieldSize = map.size();
+        m_fieldEnabled = false;
+        m_distance.clear();
+        m_fieldState.clear();
+        m_fieldOpen = {};
+        return;
+    }
+
+    if (!sameField || !m_fieldEnabled || !repairField(map))
+        restartField(goal, map);
+    drainRepairs(map);
+}
+
+void CooperativePlanner::drainRepairs(const Map& map)
+{
+    // Хвиля ремонту лежить ближче за фронт пошуку, тож іде першою, у межах того ж бюджету;
+    // незавершена продовжиться при наступному плануванні.
+    while (m_fieldEnabled && !m_fieldOpen.empty() && m_fieldOpen.top().first < m_fieldFrontier && expandField(map)) {
+    }
+}
+
+void CooperativePlanner::restartField(const QPoint& goal, const Map& map)
+{
+    m_fieldMap = &map;
+    m_fieldRevision = map.revision();
+    m_fieldGoal = goal;
+    m_fieldEnabled = true;
+
+    // Масиви виділяються лише для нового розміру; новий пошук просто бере наступне покоління.
+    const qsizetype cellCount = static_cast<qsizetype>(map.size().width()) * map.size().height();
+    if (m_fieldSize != map.size() || m_fieldState.size() != cellCount) {
+        m_fieldSize = map.size();
+        m_distance.resize(cellCount);
+        m_fieldState.fill(0, cellCount);
+        m_fieldGeneration = 0;
+    }
+    if (++m_fieldGeneration >= kMaxGeneration) {
+        m_fieldState.fill(0);
+        m_fieldGeneration = 1;
+    }
+    m_fieldOpen = {};
+    m_fieldFrontier = 0;
+
+    if (!map.isInside(goal))
+        return;
+    const qsizetype goalIndex = static_cast<qsizetype>(goal.y()) * m_fieldSize.width() + goal.x();
+    m_distance[goalIndex] = 0;
+    m_fieldState[goalIndex] = 2 * m_fieldGeneration;
+    m_fieldOpen.push({0, goalIndex});
+}
+
+bool CooperativePlanner::repairField(const Map& map)
+{
+    QVector<QPoint> changed;
+    if (!map.changesSince(m_fieldRevision, changed))
+        return false;
+    m_fieldRevision = map.revision();
+
+    const int width = m_fieldSize.width();
+    for (const QPoint& cell : std::as_const(changed)) {
+        const qsizetype index = static_cast<qsizetype>(cell.y()) * width + cell.x();
+        const int cost = enterCost(map, cell);
+        // Дорожча чи глуха клітинка на вже пройденому шляху могла зробити відстані
+        // за нею заниженими — таке виправляє лише новий пошук.
+        if (isSeen(index) && cost != kWalkCost)
+            return false;
+        if (cost < 0)
+            continue;
+
+        // Дешевша клітинка (зруйнована цегла): нова відстань — від найближчого побаченого сусіда.
+        // Далі ремонт іде хвилею через чергу, як звичайна Дейкстра.
+        int best = isSeen(index) ? m_distance.at(index) : kUnreachable;
+        for (int i = 0; i < 4; ++i) {
+            const QPoint next = cell + kMoves[i];
+            if (!map.isInside(next))
+                continue;
+            const qsizetype nextIndex = static_cast<qsizetype>(next.y()) * width + next.x();
+            if (isSeen(nextIndex))
+                best = qMin(best, m_distance.at(nextIndex) + cost);
+        }
+        if (best < kUnreachable && (!isSeen(index) || best < m_distance.at(index))) {
+            m_distance[index] = best;
+            m_fieldState[index] = 2 * m_fieldGeneration;
+            m_fieldOpen.push({best, index});
+        }
+    }
+    return true;
+}
+
+bool CooperativePlanner::expandField(const Map& map)
+{
+    const int width = m_fieldSize.width();
+    while (!m_fieldOpen.empty() && m_fieldBudget > 0) {
+        const auto [distance, index] = m_fieldOpen.top();
+        m_fieldOpen.pop();
+        if (distance > m_distance.at(index) || isClosed(index))
+            continue;
+
+        --m_fieldBudget;
+        m_fieldState[index] = 2 * m_fieldGeneration + 1;
+        m_fieldFrontier = qMax(m_fieldFrontier, distance);
+
+        const QPoint cell(static_cast<int>(index % width), static_cast<int>(index / width));
+        for (int i = 0; i < 4; ++i) {
+            const QPoint next = cell + kMoves[i];
+            if (!map.isInside(next))
+                continue;
+            const int cost = enterCost(map, next);
+            if (cost < 0)
+                continue;
+
+            // Закрита клітинка знову відкривається, якщо ремонт дав коротший шлях.
+            const qsizetype nextIndex = static_cast<qsizetype>(next.y()) * width + next.x();
+            if (!isSeen(nextIndex) || distance + cost < m_distance.at(nextIndex)) {
+                m_distance[nextIndex] = distance + cost;
+                m_fieldState[nextIndex] = 2 * m_fieldGeneration;
+                m_fieldOpen.push({distance + cost, nextIndex});
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+int CooperativePlanner::distanceAt(const QPoint& cell, const Map& map)
+{
+    if (cell.x() < 0 || cell.y() < 0 || cell.x() >= m_fieldSize.width() || cell.y() >= m_fieldSize.height())
+        return kUnreachable;
+    const int lowerBound = (cell - m_fieldGoal).manhattanLength() * kWalkCost;
+    if (!m_fieldEnabled)
+        return lowerBound;
+
+    // Зворотний пошук продовжується лише до запитаної клітинки (RRA*).
+    const qsizetype index = static_cast<qsizetype>(cell.y()) * m_fieldSize.width() + cell.x();
+    while (!isClosed(index) && expandField(map)) {
+    }
+    if (isClosed(index))
+        return m_distance.at(index);
+    // Черга вичерпана — клітинка недосяжна; вичерпаний бюджет — лише нижня межа до наступного планування.
+    return m_fieldOpen.empty() ? kUnreachable : lowerBound;
+}
+
+qint64 CooperativePlanner::stepAt(const EnemyTank& tank, int k) const
+{
+    // Час у номінальних кроках kStepMs: швидші танки проходять плитку менше ніж за крок.
+    const int msPerTile = qMax(1, tank.msPerTile());
+    return m_clockMs / kStepMs + (static_cast<qint64>(k) * msPerTile + kStepMs / 2) / kStepMs;
+}
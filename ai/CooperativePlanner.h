@@ -0,0 +1,111 @@
+#ifndef COOPERATIVEPLANNER_H
+#define COOPERATIVEPLANNER_H
+
+#include <QPoint>
+#include <QSize>
+#include <QVector>
+#include <QtGlobal>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "ai/ReservationTable.h"
+#include "gameplay/Direction.h"
+
+class EnemyTank;
+class Map;
+class OccupancyGrid;
+
+/*
+ * CooperativePlanner — віконний кооперативний A* (WHCA*) для ворогів.
+ * Кожен агент шукає шлях у просторі (клітинка, крок) лише на kWindow кроків
+ * уперед, обходячи резервування інших агентів, і резервує свій відрізок.
+ * За межами вікна оцінку дає поле відстаней до цілі: зворотна Дейкстра від цілі
+ * (цегла дорожча, бо її треба прострілити), яка, як у RRA*, продовжується лише
+ * до запитаної клітинки і не більше kMaxFieldExpansions кроків за планування;
+ * ще не досягнуті клітинки оцінюються манхеттенською відстанню. Зруйнована цегла
+ * (Map::changesSince) лише ремонтує відстані навколо себе, а повний перезапуск
+ * пошуку — тільки при новій меті, новій карті чи появі стіни на вже пройденій
+ * клітинці. Ціль поля — база, тож рухомий гравець його не скидає.
+ * На потоковій карті поля немає: пошук читає лише клітинки вікна навколо танка,
+ * які Game і так тримає в пам'яті.
+ * Вартість одного планування обмежена (2·W+1)²·(W+1) станами, kMaxExpansions
+ * і kMaxFieldExpansions, тож не залежить від розміру карти чи кількості агентів.
+ */
+class CooperativePlanner
+{
+public:
+    static constexpr int kWindow = 8;
+    static constexpr int kStepMs = 256;
+    static constexpr int kMaxExpansions = 512;
+    static constexpr int kMaxFieldExpansions = 2048;
+
+    struct Plan
+    {
+        bool found = false;
+        // Порожній напрямок — план чекати на місці один крок.
+        std::optional<Direction> direction;
+    };
+
+    void advance(int deltaMs);
+    void clear();
+    void releaseAgent(const EnemyTank* agent);
+
+    // start — клітинка, на якій танк застосує наступний запит напрямку.
+    // target — рухома ціль (гравець для FlankPlayer): вікно веде до неї за манхеттенською
+    // оцінкою, а поле до goal лише відсікає недосяжні клітинки, тож крок гравця
+    // не перебудовує поле по всій карті.
+    Plan planStep(const EnemyTank& tank, const QPoint& start, const QPoint& goal,
+                  const Map& map, const OccupancyGrid* occupancy,
+                  const std::optional<QPoint>& target = std::nullopt);
+
+    const ReservationTable& reservations() const { return m_reservations; }
+    int lastExpansions() const { return m_lastExpansions; }
+
+private:
+    struct Node
+    {
+        int f = 0;
+        int h = 0;
+        int index = 0;
+    };
+
+    using FieldEntry = std::pair<int, qsizetype>;
+
+    void ensureDistanceField(const QPoint& goal, const Map& map);
+    void restartField(const QPoint& goal, const Map& map);
+    bool repairField(const Map& map);
+    void drainRepairs(const Map& map);
+    bool expandField(const Map& map);
+    int distanceAt(const QPoint& cell, const Map& map);
+    bool isSeen(qsizetype index) const { return m_fieldState.at(index) >= 2 * m_fieldGeneration; }
+    bool isClosed(qsizetype index) const { return m_fieldState.at(index) == 2 * m_fieldGeneration + 1; }
+    qint64 stepAt(const EnemyTank& tank, int k) const;
+
+    ReservationTable m_reservations;
+    qint64 m_clockMs = 0;
+
+    // Поле відстаней до цілі й відкладений зворотний пошук, що його добудовує.
+    const Map* m_fieldMap = nullptr;
+    quint64 m_fieldRevision = 0;
+    QPoint m_fieldGoal;
+    QSize m_fieldSize;
+    bool m_fieldEnabled = false;   // false — потокова карта, оцінка манхеттенська
+    QVector<int> m_distance;       // дійсна, лише якщо клітинку вже побачено в цьому поколінні
+    // 2·покоління — клітинка в черзі, 2·покоління+1 — закрита; менше — з попереднього пошуку.
+    QVector<quint32> m_fieldState;
+    quint32 m_fieldGeneration = 0;
+    std::priority_queue<FieldEntry, std::vector<FieldEntry>, std::greater<FieldEntry>> m_fieldOpen;
+    int m_fieldFrontier = 0;       // найбільша закрита відстань; менші записи в черзі — ремонт
+    int m_fieldBudget = 0;
+
+    // Буфери пошуку перевикористовуються між викликами; актуальність — за штампом.
+    QVector<quint32> m_stamp;
+    QVector<int> m_parent;
+    quint32 m_currentStamp = 0;
+    int m_lastExpansions = 0;
+};
+
+#endif // COOPERATIVEPLANNER_H
@@ -1,9 +1,10 @@
 #include "ai/EnemyAI.h"
 
+#include "ai/AIContext.h"
 #include "gameplay/EnemyTank.h"
 
-void EnemyAI::tick(EnemyTank& tank)
+void EnemyAI::tick(EnemyTank& tank, const AIContext& context, int elapsedMs)
 {
-    m_movement.tick(tank);
-    m_shooting.tick(tank);
+    m_movement.tick(tank, context, elapsedMs);
+    m_shooting.tick(tank, context, elapsedMs);
 }
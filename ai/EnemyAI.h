@@ -5,14 +5,17 @@
 #include "ai/ShootingController.h"
 
 class EnemyTank;
+struct AIContext;
 
 /*
  * EnemyAI агрегує декілька контролерів для ухвалення простих рішень.
+ * elapsedMs — час, що минув від попереднього виклику цього агента
+ * (планувальник може пропускати тіки, тому він не дорівнює кроку симуляції).
  */
 class EnemyAI
 {
 public:
-    void tick(EnemyTank& tank);
+    void tick(EnemyTank& tank, const AIContext& context, int elapsedMs);
 
 private:
     MovementController m_movement;
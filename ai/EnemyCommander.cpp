@@ -0,0 +1,165 @@
+#include "ai/EnemyCommander.h"
+
+#include <QtConcurrent>
+#include <cmath>
+#include <vector>
+
+namespace {
+constexpr int kOrderCount = 3;
+constexpr CommanderOrder kOrders[kOrderCount] = {CommanderOrder::RushBase, CommanderOrder::FlankPlayer, CommanderOrder::Hold};
+constexpr double kExploration = 1.41;
+
+struct TreeNode
+{
+    int parent = -1;
+    int children[kOrderCount] = {-1, -1, -1};
+    int childCount = 0;
+    int depth = 0;
+    int visits = 0;
+    double value = 0.0;
+};
+
+void advanceOrder(SimState& state, CommanderOrder order)
+{
+    for (int elapsed = 0; elapsed < EnemyCommander::kDecisionMs && !state.isTerminal(); elapsed += EnemyCommander::kSimStepMs)
+        state.step(EnemyCommander::kSimStepMs, order);
+}
+
+int selectChild(const std::vector<TreeNode>& nodes, const TreeNode& node)
+{
+    const double logVisits = std::log(static_cast<double>(qMax(1, node.visits)));
+    int best = -1;
+    double bestScore = -1.0;
+    for (int i = 0; i < kOrderCount; ++i) {
+        const int childIndex = node.children[i];
+        const TreeNode& child = nodes[childIndex];
+        const double mean = child.value / qMax(1, child.visits);
+        const double score = mean + kExploration * std::sqrt(logVisits / qMax(1, child.visits));
+        if (score > bestScore) {
+            bestScore = score;
+            best = i;
+        }
+    }
+    return best;
+}
+} // namespace
+
+EnemyCommander::~EnemyCommander()
+{
+    m_search.waitForFinished();
+}
+
+void EnemyCommander::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (!m_enabled)
+        m_order.reset();
+}
+
+bool EnemyCommander::wantsSnapshot() const
+{
+    return m_enabled && !m_searchRunning && m_timerMs >= kReplanMs;
+}
+
+void EnemyCommander::submit(const SimState& snapshot)
+{
+    if (!m_enabled || m_searchRunning)
+        return;
+
+    m_timerMs = 0;
+    m_searchRunning = true;
+    const quint32 seed = ++m_seed;
+    m_search = QtConcurrent::run([snapshot, seed]() { return search(snapshot, seed); });
+}
+
+void EnemyCommander::update(int deltaMs)
+{
+    m_timerMs += deltaMs;
+    if (!m_searchRunning || !m_search.isFinished())
+        return;
+
+    m_searchRunning = false;
+    m_lastResult = m_search.result();
+    if (m_enabled)
+        m_order = m_lastResult.order;
+}
+
+void EnemyCommander::reset()
+{
+    m_search.waitForFinished();
+    m_searchRunning = false;
+    m_order.reset();
+    m_lastResult = SearchResult();
+    // перший знімок — одразу після старту рівня
+    m_timerMs = kReplanMs;
+}
+
+EnemyCommander::SearchResult EnemyCommander::search(const SimState& root, quint32 seed, int maxIterations)
+{
+    SearchResult result;
+    if (root.enemyCount() == 0)
+        return result;
+
+    // Вузол на кожну ітерацію щонайбільше, тож пам'ять виділяється один раз.
+    std::vector<TreeNode> nodes;
+    nodes.reserve(static_cast<size_t>(maxIterations) + 1);
+    nodes.emplace_back();
+
+    quint32 rng = seed ? seed : 1u;
+    const auto nextRandom = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        // Копія кореня дешева: карта спільна, доки прогін не зруйнує цеглу.
+        SimState state = root;
+        state.setSeed(nextRandom());
+
+        int nodeIndex = 0;
+        while (nodes[nodeIndex].childCount == kOrderCount && nodes[nodeIndex].depth < kHorizonDecisions
+               && !state.isTerminal()) {
+            const int choice = selectChild(nodes, nodes[nodeIndex]);
+            advanceOrder(state, kOrders[choice]);
+            nodeIndex = nodes[nodeIndex].children[choice];
+        }
+
+        if (nodes[nodeIndex].depth < kHorizonDecisions && !state.isTerminal()) {
+            const int choice = nodes[nodeIndex].childCount;
+            TreeNode child;
+            child.parent = nodeIndex;
+            child.depth = nodes[nodeIndex].depth + 1;
+            nodes.push_back(child);
+            const int childIndex = static_cast<int>(nodes.size()) - 1;
+            nodes[nodeIndex].children[choice] = childIndex;
+            ++nodes[nodeIndex].childCount;
+            advanceOrder(state, kOrders[choice]);
+            nodeIndex = childIndex;
+        }
+
+        // Випадковий прогін до горизонту.
+        for (int depth = nodes[nodeIndex].depth; depth < kHorizonDecisions && !state.isTerminal(); ++depth)
+            advanceOrder(state, kOrders[nextRandom() % kOrderCount]);
+
+        const double reward = state.evaluate();
+        for (int index = nodeIndex; index >= 0; index = nodes[index].parent) {
+            ++nodes[index].visits;
+            nodes[index].value += reward;
+        }
+        result.iterations = iteration + 1;
+    }
+
+    // Найнадійніший наказ — найбільш відвіданий нащадок кореня.
+    int bestVisits = -1;
+    for (int i = 0; i < nodes[0].childCount; ++i) {
+        const TreeNode& child = nodes[nodes[0].children[i]];
+        if (child.visits > bestVisits) {
+            bestVisits = child.visits;
+            result.order = kOrders[i];
+            result.value = child.value / qMax(1, child.visits);
+        }
+    }
+    return result;
+}
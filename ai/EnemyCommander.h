@@ -0,0 +1,60 @@
+#ifndef ENEMYCOMMANDER_H
+#define ENEMYCOMMANDER_H
+
+#include <QFuture>
+#include <QtGlobal>
+#include <optional>
+
+#include "ai/SimState.h"
+
+/*
+ * EnemyCommander — необов'язковий стратегічний рівень над EnemyAI.
+ * Раз на kReplanMs Game передає знімок SimState, а командир у робочому потоці
+ * (QtConcurrent) виконує обмежений пошук Монте-Карло по дереву (UCT) над
+ * наказами RushBase / FlankPlayer / Hold на kHorizonDecisions кроків уперед.
+ * Потік бачить лише власну копію стану; результат забирається в update()
+ * без блокування ігрового циклу, тож наказ запізнюється не більше ніж на один пошук.
+ */
+class EnemyCommander
+{
+public:
+    static constexpr int kReplanMs = 1500;
+    static constexpr int kDecisionMs = 1000;
+    static constexpr int kHorizonDecisions = 4;
+    static constexpr int kSimStepMs = 128;
+    static constexpr int kMaxIterations = 256;
+
+    struct SearchResult
+    {
+        CommanderOrder order = CommanderOrder::RushBase;
+        int iterations = 0;
+        double value = 0.0;
+    };
+
+    ~EnemyCommander();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    // Порожній, доки командир вимкнений або ще не завершив перший пошук.
+    std::optional<CommanderOrder> order() const { return m_order; }
+    const SearchResult& lastResult() const { return m_lastResult; }
+
+    bool wantsSnapshot() const;
+    void submit(const SimState& snapshot);
+    void update(int deltaMs);
+    void reset();
+
+    static SearchResult search(const SimState& root, quint32 seed, int maxIterations = kMaxIterations);
+
+private:
+    QFuture<SearchResult> m_search;
+    std::optional<CommanderOrder> m_order;
+    SearchResult m_lastResult;
+    bool m_enabled = false;
+    bool m_searchRunning = false;
+    int m_timerMs = 0;
+    quint32 m_seed = 1;
+};
+
+#endif // ENEMYCOMMANDER_H
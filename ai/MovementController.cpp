@@ -2,31 +2,129 @@
 
 #include <QPoint>
 #include <QRandomGenerator>
+#include <QVector>
 
-#include "gameplay/Direction.h"
+#include "ai/AIContext.h"
+#include "ai/CooperativePlanner.h"
+#include "ai/ThreatMap.h"
 #include "gameplay/EnemyTank.h"
 
-void MovementController::tick(EnemyTank& tank)
+namespace {
+constexpr int kTurnChancePercent = 25;
+constexpr Direction kAllDirections[] = {Direction::Up, Direction::Down, Direction::Left, Direction::Right};
+} // namespace
+
+void MovementController::tick(EnemyTank& tank, const AIContext& context, int elapsedMs)
 {
-    m_timerMs += 16;
+    m_timerMs += elapsedMs;
+
+    if (context.threats && tryDodge(tank, *context.threats)) {
+        m_timerMs = 0;
+        return;
+    }
+
+    if (tryFollowPlan(tank, context))
+        return;
+
     if (m_timerMs < m_intervalMs)
         return;
 
     m_timerMs = 0;
-    const int dir = QRandomGenerator::global()->bounded(4);
-    switch (dir) {
-    case 0: tank.setDirection(Direction::Up); break;
-    case 1: tank.setDirection(Direction::Down); break;
-    case 2: tank.setDirection(Direction::Left); break;
-    case 3: tank.setDirection(Direction::Right); break;
+    wander(tank, context);
+}
+
+bool MovementController::tryFollowPlan(EnemyTank& tank, const AIContext& context)
+{
+    if (context.order == CommanderOrder::Hold) {
+        tank.requestHold(m_intervalMs);
+        m_plannedCell.reset();
+        return true;
     }
 
-    QPoint delta(0, 0);
-    switch (tank.direction()) {
-    case Direction::Up:    delta.setY(-1); break;
-    case Direction::Down:  delta.setY(1);  break;
-    case Direction::Left:  delta.setX(-1); break;
-    case Direction::Right: delta.setX(1);  break;
+    // Поле відстаней завжди будується до бази; гравець для FlankPlayer — лише ціль вікна,
+    // інакше кожен його крок перераховував би поле по всій карті.
+    std::optional<QPoint> target;
+    if (context.order == CommanderOrder::FlankPlayer && context.playerCell.has_value())
+        target = context.playerCell;
+    const std::optional<QPoint> goal = context.baseCell.has_value() ? context.baseCell : target;
+    if (!context.planner || !context.map || !goal.has_value())
+        return false;
+
+    // Перепланування лише на новій клітинці рішення, при зміні цілі або коли старий
+    // план застарів: між ними танк їде за своїм резервуванням.
+    const QPoint decisionCell = tank.decisionCell();
+    const QPoint aim = target.value_or(*goal);
+    if (m_plannedCell == decisionCell && m_plannedGoal == aim && m_timerMs < m_intervalMs)
+        return true;
+
+    const CooperativePlanner::Plan plan =
+        context.planner->planStep(tank, decisionCell, *goal, *context.map, context.occupancy, target);
+    if (!plan.found)
+        return false;
+
+    m_timerMs = 0;
+    m_plannedCell = decisionCell;
+    m_plannedGoal = aim;
+    if (!plan.direction.has_value())
+        tank.requestHold(CooperativePlanner::kStepMs);
+    else if (isSafeStep(tank, context.threats, *plan.direction))
+        tank.requestDirection(*plan.direction);
+    return true;
+}
+
+void MovementController::wander(EnemyTank& tank, const AIContext& context)
+{
+    if (tank.random()->bounded(100) >= kTurnChancePercent)
+        return;
+
+    // уникаємо розворотів на 180 градусів, якщо є інші опції
+    const Direction opposite = EnemyTank::oppositeDirection(tank.direction());
+    QVector<Direction> candidates;
+    candidates.reserve(4);
+    for (Direction dir : kAllDirections) {
+        if (dir != opposite && tank.canMove(dir) && isSafeStep(tank, context.threats, dir))
+            candidates.append(dir);
+    }
+
+    if (candidates.isEmpty())
+        return;
+
+    tank.requestDirection(candidates.at(tank.random()->bounded(candidates.size())));
+}
+
+bool MovementController::tryDodge(EnemyTank& tank, const ThreatMap& threats) const
+{
+    // Небезпечно, якщо куля встигне до поточної або наступної клітинки,
+    // поки танк проходить одну плитку.
+    const int horizonTicks = threats.ticksForMs(tank.msPerTile());
+    const bool currentThreatened = threats.isThreatened(tank.cell(), TankType::Enemy, horizonTicks);
+    const bool aheadThreatened = !isSafeStep(tank, &threats, tank.direction());
+    if (!currentThreatened && !aheadThreatened)
+        return false;
+
+    // Перпендикулярний зсув виводить із лінії кулі, тож пробуємо його першим.
+    const bool vertical = tank.direction() == Direction::Up || tank.direction() == Direction::Down;
+    const Direction order[] = {
+        vertical ? Direction::Left : Direction::Up,
+        vertical ? Direction::Right : Direction::Down,
+        EnemyTank::oppositeDirection(tank.direction()),
+    };
+
+    for (Direction dir : order) {
+        if (tank.canMove(dir) && isSafeStep(tank, &threats, dir)) {
+            tank.requestDirection(dir);
+            return true;
+        }
     }
-    tank.setCell(tank.cell() + delta);
+
+    return false;
+}
+
+bool MovementController::isSafeStep(const EnemyTank& tank, const ThreatMap* threats, Direction direction) const
+{
+    if (!threats)
+        return true;
+
+    const QPoint next = tank.cell() + Tank::directionDelta(direction);
+    return !threats->isThreatened(next, TankType::Enemy, threats->ticksForMs(tank.msPerTile()));
 }
@@ -1,19 +1,39 @@
 #ifndef MOVEMENTCONTROLLER_H
 #define MOVEMENTCONTROLLER_H
 
+#include <QPoint>
+#include <optional>
+
+#include "gameplay/Direction.h"
+
 class EnemyTank;
+class ThreatMap;
+struct AIContext;
 
 /*
- * MovementController відповідає за просту зміну напрямку ворога.
+ * MovementController періодично обирає новий бажаний напрямок ворога.
+ * Рішення лише записується як запит: застосовує його сам танк
+ * на найближчій вирівняній клітинці, тож контролер можна викликати рідше за тік.
+ * Якщо є ThreatMap, контролер ухиляється від куль гравця і не повертає під постріл.
+ * Якщо є CooperativePlanner і база, танк їде до неї за резервованим шляхом
+ * і перепланує на кожній новій клітинці рішення; без них — блукає випадково.
+ * Наказ командира змінює ціль (база чи гравець) або зупиняє танк на місці.
  */
 class MovementController
 {
 public:
-    void tick(EnemyTank& tank);
+    void tick(EnemyTank& tank, const AIContext& context, int elapsedMs);
 
 private:
+    bool tryFollowPlan(EnemyTank& tank, const AIContext& context);
+    void wander(EnemyTank& tank, const AIContext& context);
+    bool tryDodge(EnemyTank& tank, const ThreatMap& threats) const;
+    bool isSafeStep(const EnemyTank& tank, const ThreatMap* threats, Direction direction) const;
+
     int m_timerMs = 0;
-    int m_intervalMs = 700;
+    int m_intervalMs = 600;
+    std::optional<QPoint> m_plannedCell;
+    std::optional<QPoint> m_plannedGoal;
 };
 
 #endif // MOVEMENTCONTROLLER_H
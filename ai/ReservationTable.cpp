@@ -0,0 +1,58 @@
+#include "ai/ReservationTable.h"
+
+void ReservationTable::reserve(const QPoint& cell, qint64 step, const EnemyTank* agent)
+{
+    if (!agent)
+        return;
+
+    // Слот, уже зайнятий іншим агентом, лишається за першим резервуванням.
+    const quint64 key = keyFor(cell, step);
+    if (m_slots.contains(key))
+        return;
+
+    m_slots.insert(key, agent);
+    m_agentKeys[agent].append(key);
+}
+
+void ReservationTable::releaseAgent(const EnemyTank* agent)
+{
+    const QVector<quint64> keys = m_agentKeys.take(agent);
+    for (quint64 key : keys) {
+        if (m_slots.value(key, nullptr) == agent)
+            m_slots.remove(key);
+    }
+}
+
+void ReservationTable::clear()
+{
+    m_slots.clear();
+    m_agentKeys.clear();
+}
+
+const EnemyTank* ReservationTable::owner(const QPoint& cell, qint64 step) const
+{
+    return m_slots.value(keyFor(cell, step), nullptr);
+}
+
+bool ReservationTable::isReservedByOther(const QPoint& cell, qint64 step, const EnemyTank* agent) const
+{
+    const EnemyTank* reservedBy = owner(cell, step);
+    return reservedBy && reservedBy != agent;
+}
+
+bool ReservationTable::isSwapConflict(const QPoint& from, const QPoint& to, qint64 step, const EnemyTank* agent) const
+{
+    const EnemyTank* atTarget = owner(to, step);
+    if (!atTarget || atTarget == agent)
+        return false;
+
+    return owner(from, step + 1) == atTarget;
+}
+
+quint64 ReservationTable::keyFor(const QPoint& cell, qint64 step)
+{
+    // 32 біти кроку (з переповненням) + по 16 бітів на координату.
+    return (static_cast<quint64>(static_cast<quint32>(step)) << 32)
+        | (static_cast<quint64>(static_cast<quint16>(cell.y())) << 16)
+        | static_cast<quint64>(static_cast<quint16>(cell.x()));
+}
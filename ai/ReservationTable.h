@@ -0,0 +1,37 @@
+#ifndef RESERVATIONTABLE_H
+#define RESERVATIONTABLE_H
+
+#include <QHash>
+#include <QPoint>
+#include <QVector>
+#include <QtGlobal>
+
+class EnemyTank;
+
+/*
+ * ReservationTable — просторово-часова таблиця резервувань (cell, step) → агент.
+ * Кожен агент тримає не більше вікна планування записів і знімає їх перед
+ * переплануванням, тож розмір таблиці обмежений кількістю агентів × вікно.
+ */
+class ReservationTable
+{
+public:
+    void reserve(const QPoint& cell, qint64 step, const EnemyTank* agent);
+    void releaseAgent(const EnemyTank* agent);
+    void clear();
+
+    const EnemyTank* owner(const QPoint& cell, qint64 step) const;
+    bool isReservedByOther(const QPoint& cell, qint64 step, const EnemyTank* agent) const;
+    // Зустрічний обмін клітинками: інший агент їде з to у from за той самий крок.
+    bool isSwapConflict(const QPoint& from, const QPoint& to, qint64 step, const EnemyTank* agent) const;
+
+    int size() const { return static_cast<int>(m_slots.size()); }
+
+private:
+    static quint64 keyFor(const QPoint& cell, qint64 step);
+
+    QHash<quint64, const EnemyTank*> m_slots;
+    QHash<const EnemyTank*, QVector<quint64>> m_agentKeys;
+};
+
+#endif // RESERVATIONTABLE_H
@@ -1,14 +1,109 @@
 #include "ai/ShootingController.h"
 
+#include <QRandomGenerator>
+#include <QtGlobal>
+#include <optional>
+
+#include "ai/AIContext.h"
 #include "gameplay/EnemyTank.h"
+#include "world/Map.h"
+
+namespace {
+constexpr int kFireJitterMs = 200;
+
+std::optional<Direction> directionTowards(const QPoint& from, const QPoint& to)
+{
+    if (from == to)
+        return std::nullopt;
+    if (from.x() == to.x())
+        return to.y() < from.y() ? Direction::Up : Direction::Down;
+    if (from.y() == to.y())
+        return to.x() < from.x() ? Direction::Left : Direction::Right;
+    return std::nullopt;
+}
+
+// Відстань від origin до target уздовж step або -1, якщо ціль не лежить на промені.
+int distanceAlongRay(const QPoint& origin, const QPoint& step, const QPoint& target)
+{
+    const QPoint offset = target - origin;
+    const int along = offset.x() * step.x() + offset.y() * step.y();
+    const int across = offset.x() * step.y() - offset.y() * step.x();
+    if (across != 0 || along < 0)
+        return -1;
+    return along;
+}
+} // namespace
 
-void ShootingController::tick(EnemyTank& tank)
+void ShootingController::tick(EnemyTank& tank, const AIContext& context, int elapsedMs)
 {
-    if (m_cooldownMs > 0) {
-        m_cooldownMs -= 16;
+    if (m_intervalMs <= 0)
+        resetInterval(tank);
+
+    m_elapsedMs += elapsedMs;
+    if (m_elapsedMs < m_intervalMs)
+        return;
+
+    aimAtAlignedTarget(tank, context);
+    if (!hasUsefulShot(tank, context, tank.direction()))
         return;
-    }
 
-    m_cooldownMs = m_reloadMs;
     tank.requestFire();
+    m_elapsedMs = 0;
+    resetInterval(tank);
+}
+
+void ShootingController::resetInterval(const EnemyTank& tank)
+{
+    const int cooldownMs = tank.stats().fireCooldownMs;
+    const int minInterval = qMax(50, cooldownMs - kFireJitterMs);
+    const int maxInterval = qMax(minInterval + 1, cooldownMs + kFireJitterMs + 1);
+    m_intervalMs = tank.random()->bounded(minInterval, maxInterval);
+}
+
+void ShootingController::aimAtAlignedTarget(EnemyTank& tank, const AIContext& context) const
+{
+    // Якщо гравець або база на одній лінії з танком, розвертаємось до них —
+    // сам поворот застосує EnemyTank на найближчій вирівняній клітинці.
+    for (const std::optional<QPoint>& target : {context.playerCell, context.baseCell}) {
+        if (!target.has_value())
+            continue;
+
+        const std::optional<Direction> direction = directionTowards(tank.cell(), *target);
+        if (!direction.has_value())
+            continue;
+
+        // Уже дивимося на ціль — постріл перевірить tick().
+        if (*direction == tank.direction())
+            return;
+        // Ціль за сталлю не зупиняє перебір: наступною може бути база.
+        if (!hasUsefulShot(tank, context, *direction))
+            continue;
+
+        tank.requestDirection(*direction);
+        return;
+    }
+}
+
+bool ShootingController::hasUsefulShot(const EnemyTank& tank, const AIContext& context, Direction direction) const
+{
+    const Map* map = context.map ? context.map : tank.map();
+    if (!map)
+        return true;
+
+    // WeaponSystem створює кулю в сусідній клітинці — з неї й починаємо промінь.
+    const QPoint step = Tank::directionDelta(direction);
+    const QPoint origin = tank.cell() + step;
+    const BulletRayHit hit = map->castBulletRay(origin, step, tank.bulletCanPierceSteel());
+
+    if (context.playerCell.has_value()) {
+        const int playerDistance = distanceAlongRay(origin, step, *context.playerCell);
+        if (playerDistance >= 0 && (!hit.blocked || playerDistance < hit.distance))
+            return true;
+    }
+
+    if (!hit.blocked || !hit.inside)
+        return false;
+
+    // База і цегла — корисні влучання; сталь та край карти лише плодять кулі.
+    return hit.type == TileType::Base || hit.type == TileType::Brick;
 }
@@ -1,19 +1,32 @@
 #ifndef SHOOTINGCONTROLLER_H
 #define SHOOTINGCONTROLLER_H
 
+#include <QPoint>
+
+#include "gameplay/Direction.h"
+
 class EnemyTank;
+struct AIContext;
 
 /*
- * ShootingController контролює частоту пострілів ворога.
+ * ShootingController контролює частоту та доцільність пострілів ворога.
+ * Інтервал береться з EnemyStats і розмивається випадковим джитером;
+ * коли він минає, постріл виконується лише якщо промінь по Map::castBulletRay
+ * досягає гравця, бази або цегли. Інакше контролер тримає готовність
+ * і повертається до перевірки при наступному виклику.
  */
 class ShootingController
 {
 public:
-    void tick(EnemyTank& tank);
+    void tick(EnemyTank& tank, const AIContext& context, int elapsedMs);
 
 private:
-    int m_cooldownMs = 0;
-    int m_reloadMs = 900;
+    void resetInterval(const EnemyTank& tank);
+    void aimAtAlignedTarget(EnemyTank& tank, const AIContext& context) const;
+    bool hasUsefulShot(const EnemyTank& tank, const AIContext& context, Direction direction) const;
+
+    int m_elapsedMs = 0;
+    int m_intervalMs = 0;
 };
 
 #endif // SHOOTINGCONTROLLER_H
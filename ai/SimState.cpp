@@ -0,0 +1,276 @@
+#include "ai/SimState.h"
+
+#include "core/GameState.h"
+#include "gameplay/EnemyTank.h"
+#include "gameplay/PlayerTank.h"
+#include "world/Base.h"
+#include "world/Map.h"
+#include "world/Tile.h"
+
+namespace {
+constexpr Direction kAllDirections[] = {Direction::Up, Direction::Down, Direction::Left, Direction::Right};
+} // namespace
+
+SimState SimState::capture(const Map& map, const QList<EnemyTank*>& enemies, const PlayerTank* player,
+                           const Base* base, const GameState& state)
+{
+    SimState sim;
+    sim.m_width = map.size().width();
+    sim.m_height = map.size().height();
+    sim.m_tiles.resize(static_cast<qsizetype>(sim.m_width) * sim.m_height);
+    for (int y = 0; y < sim.m_height; ++y) {
+        for (int x = 0; x < sim.m_width; ++x) {
+            const QPoint cell(x, y);
+            const Tile tile = map.tile(cell);
+            quint8 flags = 0;
+            if (map.isWalkable(cell))
+                flags |= Walkable;
+            if (tile.blockMask & BlockBullet)
+                flags |= StopsBullet;
+            if (tile.type == TileType::Brick)
+                flags |= Brick;
+            if (tile.type == TileType::Base)
+                flags |= BaseTile;
+            sim.m_tiles[y * sim.m_width + x] = flags;
+        }
+    }
+
+    sim.m_enemies.reserve(enemies.size());
+    for (const EnemyTank* enemy : enemies) {
+        if (!enemy || enemy->isDestroyed())
+            continue;
+
+        SimTank tank;
+        tank.cell = enemy->decisionCell();
+        tank.direction = enemy->direction();
+        tank.msPerTile = static_cast<qint16>(qBound(1, enemy->msPerTile(), 30000));
+        tank.fireCooldownMs = static_cast<qint16>(qBound(1, enemy->stats().fireCooldownMs, 30000));
+        tank.hits = static_cast<quint8>(qBound(1, enemy->armorHitsRemaining(), 255));
+        sim.m_enemies.append(tank);
+    }
+
+    if (player && !player->isDestroyed()) {
+        sim.m_playerCell = player->cell();
+        sim.m_playerAlive = true;
+    }
+    sim.m_playerSpawn = sim.m_playerCell;
+    sim.m_playerLives = state.remainingLives();
+    if (base) {
+        sim.m_baseCell = base->cell();
+        sim.m_baseHealth = base->health();
+    }
+
+    sim.m_initialEnemies = static_cast<int>(sim.m_enemies.size());
+    sim.m_initialPlayerLives = sim.m_playerLives;
+    return sim;
+}
+
+void SimState::step(int ms, CommanderOrder order)
+{
+    if (isTerminal())
+        return;
+
+    m_elapsedMs += ms;
+    for (qsizetype i = 0; i < m_enemies.size(); ++i)
+        stepEnemy(i, ms, order);
+    stepPlayer(ms);
+}
+
+double SimState::evaluate() const
+{
+    if (m_baseHealth <= 0)
+        return 1.0;
+    if (m_initialEnemies == 0)
+        return 0.0;
+
+    // Наближення до бази, втрачені життя гравця і власні втрати.
+    int closest = m_width + m_height;
+    for (const SimTank& tank : m_enemies) {
+        const int distance = (tank.cell - m_baseCell).manhattanLength();
+        closest = qMin(closest, distance);
+    }
+
+    const double span = qMax(1, m_width + m_height);
+    const double approach = 1.0 - closest / span;
+    const double livesTaken = m_initialPlayerLives > 0
+        ? static_cast<double>(m_initialPlayerLives - m_playerLives) / m_initialPlayerLives
+        : 0.0;
+    const double losses = static_cast<double>(m_enemiesLost) / m_initialEnemies;
+    return qBound(0.0, 0.2 + 0.4 * approach + 0.3 * livesTaken - 0.3 * losses, 1.0);
+}
+
+quint32 SimState::nextRandom()
+{
+    // xorshift32: генератор живе у стані, тож копії відтворювані.
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 17;
+    m_rng ^= m_rng << 5;
+    return m_rng;
+}
+
+quint8 SimState::flagsAt(const QPoint& cell) const
+{
+    if (cell.x() < 0 || cell.y() < 0 || cell.x() >= m_width || cell.y() >= m_height)
+        return StopsBullet;
+
+    return m_tiles.at(cell.y() * m_width + cell.x());
+}
+
+bool SimState::isOccupied(const QPoint& cell, qsizetype self) const
+{
+    if (m_playerAlive && m_playerCell == cell)
+        return true;
+
+    for (qsizetype i = 0; i < m_enemies.size(); ++i) {
+        if (i != self && m_enemies.at(i).cell == cell)
+            return true;
+    }
+    return false;
+}
+
+Direction SimState::desiredDirection(const SimTank& tank, CommanderOrder order) const
+{
+    if (order == CommanderOrder::Hold)
+        return tank.direction;
+
+    const QPoint target = (order == CommanderOrder::FlankPlayer && m_playerAlive) ? m_playerCell : m_baseCell;
+    const QPoint delta = target - tank.cell;
+    const Direction horizontal = delta.x() < 0 ? Direction::Left : Direction::Right;
+    const Direction vertical = delta.y() < 0 ? Direction::Up : Direction::Down;
+    const bool preferHorizontal = qAbs(delta.x()) > qAbs(delta.y());
+    const Direction first = preferHorizontal ? horizontal : vertical;
+    const Direction second = preferHorizontal ? vertical : horizontal;
+
+    if (flagsAt(tank.cell + Tank::directionDelta(first)) & Walkable)
+        return first;
+    if ((preferHorizontal ? delta.y() : delta.x()) != 0 && (flagsAt(tank.cell + Tank::directionDelta(second)) & Walkable))
+        return second;
+    return tank.direction;
+}
+
+void SimState::stepEnemy(qsizetype index, int ms, CommanderOrder order)
+{
+    SimTank& tank = m_enemies[index];
+
+    tank.fireTimerMs = static_cast<qint16>(tank.fireTimerMs + ms);
+    if (tank.fireTimerMs >= tank.fireCooldownMs) {
+        tank.fireTimerMs = 0;
+        fireEnemy(tank);
+        if (isTerminal())
+            return;
+    }
+
+    if (order == CommanderOrder::Hold)
+        return;
+
+    tank.moveMs = static_cast<qint16>(tank.moveMs + ms);
+    while (tank.moveMs >= tank.msPerTile) {
+        tank.moveMs = static_cast<qint16>(tank.moveMs - tank.msPerTile);
+
+        tank.direction = desiredDirection(tank, order);
+        if (!(flagsAt(tank.cell + Tank::directionDelta(tank.direction)) & Walkable))
+            rerouteEnemy(tank, index);
+
+        const QPoint next = tank.cell + Tank::directionDelta(tank.direction);
+        if (!(flagsAt(next) & Walkable)) {
+            tank.moveMs = 0;
+            break;
+        }
+        if (isOccupied(next, index)) {
+            tank.waitMs = static_cast<qint16>(tank.waitMs + tank.msPerTile);
+            if (tank.waitMs >= EnemyTank::kMaxTankWaitMs) {
+                tank.waitMs = 0;
+                rerouteEnemy(tank, index);
+            }
+            tank.moveMs = 0;
+            break;
+        }
+
+        tank.waitMs = 0;
+        tank.cell = next;
+    }
+}
+
+void SimState::rerouteEnemy(SimTank& tank, qsizetype index)
+{
+    Direction candidates[4];
+    int count = 0;
+    const Direction opposite = EnemyTank::oppositeDirection(tank.direction);
+    bool oppositeOpen = false;
+    for (Direction dir : kAllDirections) {
+        const QPoint next = tank.cell + Tank::directionDelta(dir);
+        if (!(flagsAt(next) & Walkable) || isOccupied(next, index))
+            continue;
+        if (dir == opposite) {
+            oppositeOpen = true;
+            continue;
+        }
+        candidates[count++] = dir;
+    }
+
+    // уникаємо розворотів на 180 градусів, якщо є інші опції
+    if (count == 0 && oppositeOpen)
+        candidates[count++] = opposite;
+    if (count == 0)
+        return;
+
+    tank.direction = candidates[nextRandom() % static_cast<quint32>(count)];
+}
+
+void SimState::fireEnemy(const SimTank& tank)
+{
+    const QPoint step = Tank::directionDelta(tank.direction);
+    for (QPoint cell = tank.cell + step;; cell += step) {
+        if (m_playerAlive && cell == m_playerCell) {
+            --m_playerLives;
+            m_playerAlive = m_playerLives > 0;
+            m_playerCell = m_playerSpawn;
+            return;
+        }
+
+        const quint8 flags = flagsAt(cell);
+        if (!(flags & StopsBullet))
+            continue;
+
+        if (flags & BaseTile)
+            --m_baseHealth;
+        else if (flags & Brick)
+            destroyTileAt(cell);
+        return;
+    }
+}
+
+void SimState::stepPlayer(int ms)
+{
+    if (!m_playerAlive)
+        return;
+
+    // Гравець-суперник: нерухомий, б'є першого ворога на вільній лінії.
+    m_playerFireTimerMs += ms;
+    if (m_playerFireTimerMs < Tank::kDefaultReloadMs)
+        return;
+
+    for (Direction dir : kAllDirections) {
+        const QPoint step = Tank::directionDelta(dir);
+        for (QPoint cell = m_playerCell + step; !(flagsAt(cell) & StopsBullet); cell += step) {
+            for (qsizetype i = 0; i < m_enemies.size(); ++i) {
+                SimTank& enemy = m_enemies[i];
+                if (enemy.cell != cell)
+                    continue;
+
+                m_playerFireTimerMs = 0;
+                if (--enemy.hits == 0) {
+                    m_enemies.removeAt(i);
+                    ++m_enemiesLost;
+                }
+                return;
+            }
+        }
+    }
+}
+
+void SimState::destroyTileAt(const QPoint& cell)
+{
+    // Єдине місце запису в карту: тут QVector відокремлює свою копію.
+    m_tiles[cell.y() * m_width + cell.x()] = Walkable;
+}
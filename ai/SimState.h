@@ -0,0 +1,96 @@
+#ifndef SIMSTATE_H
+#define SIMSTATE_H
+
+#include <QList>
+#include <QPoint>
+#include <QVector>
+#include <QtGlobal>
+
+#include "gameplay/Direction.h"
+
+class Base;
+class EnemyTank;
+class GameState;
+class Map;
+class PlayerTank;
+
+// Загальний наказ командира для всіх ворогів.
+enum class CommanderOrder : quint8 {
+    RushBase,
+    FlankPlayer,
+    Hold
+};
+
+/*
+ * SimState — стиснений знімок бою для прогонів EnemyCommander.
+ * Карта — байтові прапорці з неявним спільним доступом (QVector), тож копія
+ * стану коштує кілька лічильників посилань і відокремлюється лише при руйнуванні цегли.
+ * Рух — по цілих клітинках за правилами EnemyTank::updateWithDelta:
+ * плитка за msPerTile, обхід стіни випадковим напрямком без розвороту,
+ * коротке очікування перед іншим танком. Постріли миттєві вздовж променя.
+ */
+class SimState
+{
+public:
+    static SimState capture(const Map& map, const QList<EnemyTank*>& enemies, const PlayerTank* player,
+                            const Base* base, const GameState& state);
+
+    void step(int ms, CommanderOrder order);
+    bool isTerminal() const { return m_baseHealth <= 0 || m_enemies.isEmpty(); }
+    // Оцінка з погляду ворогів у [0, 1].
+    double evaluate() const;
+
+    int enemyCount() const { return static_cast<int>(m_enemies.size()); }
+    void setSeed(quint32 seed) { m_rng = seed ? seed : 1u; }
+
+private:
+    enum TileFlag : quint8 {
+        Walkable = 1 << 0,
+        Brick = 1 << 1,
+        StopsBullet = 1 << 2,
+        BaseTile = 1 << 3
+    };
+
+    struct SimTank
+    {
+        QPoint cell;
+        Direction direction = Direction::Down;
+        qint16 msPerTile = 256;
+        qint16 moveMs = 0;
+        qint16 waitMs = 0;
+        qint16 fireCooldownMs = 1000;
+        qint16 fireTimerMs = 0;
+        quint8 hits = 1;
+    };
+
+    quint32 nextRandom();
+    quint8 flagsAt(const QPoint& cell) const;
+    bool isOccupied(const QPoint& cell, qsizetype self) const;
+    Direction desiredDirection(const SimTank& tank, CommanderOrder order) const;
+    void stepEnemy(qsizetype index, int ms, CommanderOrder order);
+    void rerouteEnemy(SimTank& tank, qsizetype index);
+    void fireEnemy(const SimTank& tank);
+    void destroyTileAt(const QPoint& cell);
+    void stepPlayer(int ms);
+
+    int m_width = 0;
+    int m_height = 0;
+    QVector<quint8> m_tiles;
+    QVector<SimTank> m_enemies;
+
+    QPoint m_baseCell;
+    QPoint m_playerCell;
+    QPoint m_playerSpawn;
+    bool m_playerAlive = false;
+    int m_playerLives = 0;
+    int m_playerFireTimerMs = 0;
+    int m_baseHealth = 0;
+
+    int m_initialEnemies = 0;
+    int m_initialPlayerLives = 0;
+    int m_enemiesLost = 0;
+    int m_elapsedMs = 0;
+    quint32 m_rng = 1;
+};
+
+#endif // SIMSTATE_H
@@ -0,0 +1,122 @@
+#include "ai/ThreatMap.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "gameplay/Bullet.h"
+#include "world/Map.h"
+
+void ThreatMap::clear()
+{
+    m_size = QSize();
+    m_threatToPlayer.clear();
+    m_threatToEnemy.clear();
+    m_touched.clear();
+    m_originIndex.clear();
+    m_stride.clear();
+    m_length.clear();
+    m_firstStepMs.clear();
+    m_stepMs.clear();
+    m_hitsPlayer.clear();
+}
+
+void ThreatMap::rebuild(const Map& map, const QList<Bullet*>& bullets, int tickMs)
+{
+    m_tickMs = qMax(1, tickMs);
+
+    const QSize size = map.size();
+    if (size != m_size) {
+        m_size = size;
+        const qsizetype cellCount = static_cast<qsizetype>(size.width()) * size.height();
+        m_threatToPlayer.fill(kNoThreat, cellCount);
+        m_threatToEnemy.fill(kNoThreat, cellCount);
+        m_touched.clear();
+    } else {
+        resetTouchedCells();
+    }
+
+    // Прохід 1: збираємо кулі у плоскі масиви. Тут же обрізаємо траєкторію
+    // до першої перешкоди, щоби далі працювати лише з числами.
+    m_originIndex.clear();
+    m_stride.clear();
+    m_length.clear();
+    m_firstStepMs.clear();
+    m_stepMs.clear();
+    m_hitsPlayer.clear();
+
+    for (const Bullet* bullet : bullets) {
+        if (!bullet || !bullet->isAlive() || !map.isInside(bullet->cell()))
+            continue;
+
+        const QPoint step = bullet->directionDelta();
+        const BulletRayHit hit = map.castBulletRay(bullet->cell(), step, bullet->canPierceSteel());
+        if (hit.distance <= 0)
+            continue;
+
+        m_originIndex.append(indexOf(bullet->cell()));
+        m_stride.append(static_cast<qsizetype>(step.y()) * m_size.width() + step.x());
+        m_length.append(hit.distance);
+        m_firstStepMs.append(static_cast<int>(std::ceil(bullet->msUntilNextCell())));
+        m_stepMs.append(bullet->stepIntervalMs());
+        m_hitsPlayer.append(bullet->type() == TankType::Enemy ? 1 : 0);
+    }
+
+    // Прохід 2: лінійна розгортка без звернень до Map чи Bullet.
+    const qsizetype count = m_originIndex.size();
+    for (qsizetype i = 0; i < count; ++i) {
+        quint16* layer = m_hitsPlayer.at(i) ? m_threatToPlayer.data() : m_threatToEnemy.data();
+        const qsizetype stride = m_stride.at(i);
+        const int length = m_length.at(i);
+        const int firstStepMs = m_firstStepMs.at(i);
+        const int stepMs = m_stepMs.at(i);
+
+        qsizetype index = m_originIndex.at(i);
+        for (int k = 0; k < length; ++k, index += stride) {
+            const int arrivalMs = k == 0 ? 0 : firstStepMs + (k - 1) * stepMs;
+            const int ticks = std::min<int>((arrivalMs + m_tickMs - 1) / m_tickMs, kNoThreat - 1);
+            quint16& slot = layer[index];
+            if (slot == kNoThreat)
+                m_touched.append(index);
+            slot = std::min<quint16>(slot, static_cast<quint16>(ticks));
+        }
+    }
+}
+
+quint16 ThreatMap::ticksUntilImpact(const QPoint& cell, TankType target) const
+{
+    const qsizetype index = indexOf(cell);
+    if (index < 0)
+        return kNoThreat;
+
+    return target == TankType::Player ? m_threatToPlayer.at(index) : m_threatToEnemy.at(index);
+}
+
+bool ThreatMap::isThreatened(const QPoint& cell, TankType target, int withinTicks) const
+{
+    const quint16 ticks = ticksUntilImpact(cell, target);
+    return ticks != kNoThreat && ticks <= withinTicks;
+}
+
+int ThreatMap::ticksForMs(int ms) const
+{
+    return qMax(0, (ms + m_tickMs - 1) / m_tickMs);
+}
+
+qsizetype ThreatMap::indexOf(const QPoint& cell) const
+{
+    if (cell.x() < 0 || cell.y() < 0 || cell.x() >= m_size.width() || cell.y() >= m_size.height())
+        return -1;
+
+    return static_cast<qsizetype>(cell.y()) * m_size.width() + cell.x();
+}
+
+void ThreatMap::resetTouchedCells()
+{
+    // Скидаємо лише клітинки, зачеплені минулого тіку, а не всю сітку —
+    // вартість очищення пропорційна кількості куль, а не площі карти.
+    for (qsizetype index : m_touched) {
+        m_threatToPlayer[index] = kNoThreat;
+        m_threatToEnemy[index] = kNoThreat;
+    }
+    m_touched.clear();
+}
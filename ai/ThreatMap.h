@@ -0,0 +1,58 @@
+#ifndef THREATMAP_H
+#define THREATMAP_H
+
+#include <QList>
+#include <QPoint>
+#include <QSize>
+#include <QVector>
+#include <QtGlobal>
+#include <limits>
+
+#include "enums/enums.h"
+
+class Bullet;
+class Map;
+
+/*
+ * ThreatMap — сітка небезпеки на поточний тік.
+ * Кожна жива куля проєктується вздовж свого напрямку до першої клітинки,
+ * що її зупинить (Map::castBulletRay), і в кожну клітинку шляху записується
+ * мінімальна кількість тіків до влучання. Окремі шари для куль гравця і ворогів,
+ * бо своїм кулі не шкодять. Запит — O(1) за індексом клітинки.
+ */
+class ThreatMap
+{
+public:
+    static constexpr quint16 kNoThreat = std::numeric_limits<quint16>::max();
+
+    void rebuild(const Map& map, const QList<Bullet*>& bullets, int tickMs);
+    void clear();
+
+    // Тіки до влучання кулі, небезпечної для танка типу target, або kNoThreat.
+    quint16 ticksUntilImpact(const QPoint& cell, TankType target) const;
+    bool isThreatened(const QPoint& cell, TankType target, int withinTicks) const;
+    int ticksForMs(int ms) const;
+
+    int tickMs() const { return m_tickMs; }
+    int projectedBullets() const { return static_cast<int>(m_originIndex.size()); }
+
+private:
+    qsizetype indexOf(const QPoint& cell) const;
+    void resetTouchedCells();
+
+    QSize m_size;
+    int m_tickMs = 16;
+    QVector<quint16> m_threatToPlayer;
+    QVector<quint16> m_threatToEnemy;
+    QVector<qsizetype> m_touched;
+
+    // Плоский масив куль (structure of arrays), зібраний одним проходом перед проєкцією.
+    QVector<qsizetype> m_originIndex;
+    QVector<qsizetype> m_stride;
+    QVector<int> m_length;
+    QVector<int> m_firstStepMs;
+    QVector<int> m_stepMs;
+    QVector<quint8> m_hitsPlayer;
+};
+
+#endif // THREATMAP_H
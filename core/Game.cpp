@@ -1,19 +1,32 @@
 #include "core/Game.h"
 
+#include <QDebug>
+#include <QRect>
 #include <QtGlobal>
-
+#include <utility>
+
+#include "ai/AIContext.h"
+#include "ai/AIScheduler.h"
+#include "ai/CooperativePlanner.h"
+#include "ai/EnemyCommander.h"
+#include "ai/SimState.h"
+#include "ai/ThreatMap.h"
 #include "gameplay/EnemyTank.h"
 #include "gameplay/PlayerTank.h"
 #include "gameplay/Bullet.h"
 #include "gameplay/Direction.h"
 #include "gameplay/Bonus.h"
 #include "core/GameRules.h"
+#include "core/SessionRecording.h"
 #include "systems/InputSystem.h"
 #include "systems/PhysicsSystem.h"
 #include "systems/CollisionSystem.h"
 #include "world/Base.h"
+#include "world/LevelGenerator.h"
 #include "world/LevelLoader.h"
+#include "world/LevelPreloader.h"
 #include "world/Map.h"
+#include "world/OccupancyGrid.h"
 #include "world/Tile.h"
 #include <QRandomGenerator>
 
@@ -21,12 +34,21 @@ namespace {
 constexpr int kBonusSpawnIntervalMinMs = 15000;
 constexpr int kBonusSpawnIntervalMaxMs = 20000;
 constexpr int kEnemyKillsPerBonus = 4;
+// Радіус робочої множини потокової карти навколо кожного танка й бази, у клітинках.
+constexpr int kStreamingRadiusCells = 32;
 }
 Game::Game(QObject* parent)
     : QObject(parent),
       m_levelLoader(std::make_unique<LevelLoader>()),
+      m_levelPreloader(std::make_unique<LevelPreloader>()),
       m_physicsSystem(std::make_unique<PhysicsSystem>()),
-      m_collisionSystem(std::make_unique<CollisionSystem>())
+      m_collisionSystem(std::make_unique<CollisionSystem>()),
+      m_aiScheduler(std::make_unique<AIScheduler>()),
+      m_threatMap(std::make_unique<ThreatMap>()),
+      m_occupancy(std::make_unique<OccupancyGrid>()),
+      m_planner(std::make_unique<CooperativePlanner>()),
+      m_commander(std::make_unique<EnemyCommander>()),
+      m_random(std::make_unique<QRandomGenerator>())
 {
 }
 
@@ -43,6 +65,41 @@ void Game::startNewGame()
 void Game::setPendingLevelIndex(int index)
 {
     m_pendingLevelIndex = index;
+    m_pendingLevelSeed.reset();
+}
+
+void Game::setPendingLevelSeed(quint64 seed)
+{
+    m_pendingLevelSeed = seed;
+    m_pendingLevelIndex.reset();
+}
+
+void Game::preloadLevel(int index)
+{
+    m_levelPreloader->request(qMax(0, index), m_rules);
+}
+
+void Game::preloadSavedLevel()
+{
+    m_levelPreloader->request(LevelPreloader::kSavedLevel, m_rules);
+}
+
+void Game::preloadCurrentLevel()
+{
+    // Згенерований рівень будується з зерна під час старту, готувати у фоні нічого.
+    if (m_currentLevelSeed.has_value())
+        return;
+    if (m_currentLevelIndex.has_value())
+        preloadLevel(*m_currentLevelIndex);
+    else
+        preloadSavedLevel();
+}
+
+bool Game::hasNextLevel() const
+{
+    if (!m_currentLevelIndex.has_value() || !m_levelLoader)
+        return false;
+    return *m_currentLevelIndex + 1 < m_levelLoader->availableLevelFiles().size();
 }
 
 void Game::initialize()
@@ -51,6 +108,7 @@ void Game::initialize()
     // Поки що готуємо лише базовий стан сесії.
 
     clearWorld();
+    reseedRandom();
 
     const int totalEnemies = m_rules.enemiesPerWave() * m_rules.totalWaves();
     m_state.reset(m_rules.playerLives(), totalEnemies);
@@ -59,16 +117,31 @@ void Game::initialize()
     if (!m_levelLoader)
         m_levelLoader = std::make_unique<LevelLoader>();
 
+    m_currentLevelIndex = m_pendingLevelIndex;
+    m_pendingLevelIndex.reset();
+    m_currentLevelSeed = m_pendingLevelSeed;
+    m_pendingLevelSeed.reset();
+
+    // Рівень, підготовлений у фоні під час меню, забирається без читання файлів.
+    const int levelKey = m_currentLevelIndex.value_or(LevelPreloader::kSavedLevel);
     LevelData level;
-    if (m_pendingLevelIndex.has_value()) {
-        level = m_levelLoader->loadLevelByIndex(*m_pendingLevelIndex, m_rules);
-        m_pendingLevelIndex.reset();
-    } else {
+    if (m_currentLevelSeed.has_value()) {
+        LevelGeneratorParams params;
+        params.seed = *m_currentLevelSeed;
+        params.size = m_rules.mapSize();
+        level = m_levelLoader->generateLevel(params, m_rules);
+    } else if (std::optional<LevelData> preloaded = m_levelPreloader->take(levelKey, m_rules)) {
+        level = std::move(*preloaded);
+    }
+    if (!level.map && m_currentLevelIndex.has_value())
+        level = m_levelLoader->loadLevelByIndex(*m_currentLevelIndex, m_rules);
+    else if (!level.map)
         level = m_levelLoader->loadSavedLevel(m_rules);
-    }
     m_map = std::move(level.map);
+    if (m_map)
+        m_occupancy->resize(m_map->size());
 
-    if (!level.loadedFromFile) {
+    if (!level.loadedFromFile && !level.procedural) {
         const QPoint iceStart(3, 3);
         for (int offset = 0; offset < 4; ++offset) {
             const QPoint cell = iceStart + QPoint(offset, 0);
@@ -96,6 +169,7 @@ void Game::initialize()
 
     auto player = std::make_unique<PlayerTank>(level.playerSpawn);
     player->setMap(m_map.get());
+    player->setOccupancy(m_occupancy.get());
     player->setInput(m_inputSystem);
 
     m_player = player.get();
@@ -104,12 +178,37 @@ void Game::initialize()
     m_enemyKillsSinceBonus = 0;
     m_bonusSpawnTimerMs = rollBonusSpawnIntervalMs();
     m_enemyFreezeTimerMs = 0;
+    // Асинхронний командир і бюджет часу AI залежать від швидкості машини.
+    const bool deterministic = m_rules.deterministic();
+    m_commander->setEnabled(m_rules.enemyCommanderEnabled() && !deterministic);
+    m_aiScheduler->setBudgetUs(deterministic ? AIScheduler::kUnlimitedBudget : AIScheduler::kDefaultBudgetUs);
+    if (m_recording)
+        m_recording->start(m_rules, m_currentLevelIndex, m_currentLevelSeed, m_sessionSeed);
 
     updateEnemySpawning(0);
+
+    if (hasNextLevel())
+        preloadLevel(*m_currentLevelIndex + 1);
+}
+
+void Game::reseedRandom()
+{
+    m_sessionSeed = m_pendingSessionSeed.value_or(QRandomGenerator::global()->generate64());
+    m_pendingSessionSeed.reset();
+    const quint32 seedWords[2] = {static_cast<quint32>(m_sessionSeed), static_cast<quint32>(m_sessionSeed >> 32)};
+    m_random = std::make_unique<QRandomGenerator>(seedWords, 2);
 }
 
 void Game::restart()
 {
+    // Без явно обраного рівня (Next Level) перезапускається поточний: згенерований —
+    // з того самого зерна, а не підміняється збереженим Demo.txt.
+    if (!m_pendingLevelIndex.has_value() && !m_pendingLevelSeed.has_value()) {
+        if (m_currentLevelSeed.has_value())
+            m_pendingLevelSeed = m_currentLevelSeed;
+        else
+            m_pendingLevelIndex = m_currentLevelIndex;
+    }
     initialize();
 }
 
@@ -135,6 +234,8 @@ void Game::enterMainMenu()
 void Game::enterEditor()
 {
     clearWorld();
+    // Редактор може перезаписати файли рівнів — підготовлені копії вже не актуальні.
+    m_levelPreloader->clear();
 
     if (!m_levelLoader)
         m_levelLoader = std::make_unique<LevelLoader>();
@@ -168,6 +269,10 @@ void Game::update(int deltaMs)
     if (m_state.gameMode() != GameMode::Playing)
         return;
 
+    // Знімок вводу до того, як PlayerTank його прочитає: саме його відтворення поверне на цьому тіку.
+    if (m_recording)
+        m_recording->appendTick(m_inputSystem ? m_inputSystem->snapshot() : 0, deltaMs);
+
     cleanupDestroyed();
 
     evaluateSessionState();
@@ -180,6 +285,7 @@ void Game::update(int deltaMs)
         return;
 
     updatePlayerRespawn(deltaMs);
+    retainStreamedChunks();
     updateTanks(deltaMs);
     spawnPendingBullets();
 
@@ -212,12 +318,32 @@ void Game::clearWorld()
         delete tank;
     m_tanks.clear();
     m_enemies.clear();
+    if (m_aiScheduler)
+        m_aiScheduler->clear();
+    if (m_threatMap)
+        m_threatMap->clear();
+    // танки вже видалені й звільнили свої клітинки
+    if (m_occupancy)
+        m_occupancy->resize(QSize());
+    if (m_planner)
+        m_planner->clear();
+    // пошук у робочому потоці працює на власній копії, але результат уже не потрібен
+    if (m_commander)
+        m_commander->reset();
     m_enemySpawnOrder.clear();
+    if (m_map && m_map->isStreamed()) {
+        const MapStorageStats stats = m_map->storageStats();
+        qInfo() << "Map streaming:" << stats.residentChunks << "of" << stats.chunkCount << "chunks resident,"
+                 << stats.pageIns << "page-ins, avg"
+                 << (stats.pageIns ? stats.pageInNsTotal / static_cast<qint64>(stats.pageIns) / 1000 : 0)
+                 << "us, max" << stats.pageInNsMax / 1000 << "us," << stats.writeBacks << "write-backs";
+    }
     m_map.reset();
     m_base.reset();
     m_player = nullptr;
     m_playerSpawnCell = QPoint();
     m_playerRespawnTimerMs = 0;
+    m_viewCells = QRect();
     m_enemySpawnPoints.clear();
     m_bonusSpawnTimerMs = 0;
     m_enemyKillsSinceBonus = 0;
@@ -225,8 +351,45 @@ void Game::clearWorld()
     m_nextEnemyTypeIndex = 0;
 }
 
+void Game::retainStreamedChunks()
+{
+    if (!m_map || !m_map->isStreamed())
+        return;
+
+    // Робоча множина — околиці танків і бази; решту Map вивантажує понад бюджет.
+    const QPoint margin(kStreamingRadiusCells, kStreamingRadiusCells);
+    QVector<QRect> areas;
+    areas.reserve(m_tanks.size() + 1);
+    for (Tank* tank : std::as_const(m_tanks)) {
+        if (tank)
+            areas.append(QRect(tank->cell() - margin, tank->cell() + margin));
+    }
+    if (m_base)
+        areas.append(QRect(m_base->cell() - margin, m_base->cell() + margin));
+    if (!m_viewCells.isEmpty())
+        areas.append(m_viewCells);
+    m_map->retainAreas(areas);
+}
+
 void Game::updateTanks(int deltaMs)
 {
+    // Рішення AI ухвалюються до кроку руху, щоби запити напрямку/пострілу
+    // застосувались у тому ж тіку. Карта загроз будується одним проходом по кулях.
+    if (m_threatMap && m_map)
+        m_threatMap->rebuild(*m_map, m_bullets, deltaMs);
+
+    if (m_planner)
+        m_planner->advance(deltaMs);
+
+    if (m_commander && m_commander->isEnabled()) {
+        m_commander->update(deltaMs);
+        if (m_commander->wantsSnapshot() && m_map)
+            m_commander->submit(SimState::capture(*m_map, m_enemies, m_player, m_base.get(), m_state));
+    }
+
+    if (m_aiScheduler)
+        m_aiScheduler->update(buildAIContext(), deltaMs);
+
     for (Tank* tank : m_tanks) {
         if (!tank)
             continue;
@@ -238,6 +401,22 @@ void Game::updateTanks(int deltaMs)
     }
 }
 
+AIContext Game::buildAIContext() const
+{
+    AIContext context;
+    context.map = m_map.get();
+    if (m_player && !m_player->isDestroyed())
+        context.playerCell = m_player->cell();
+    if (m_base && !m_base->isDestroyed())
+        context.baseCell = m_base->cell();
+    context.threats = m_threatMap.get();
+    context.occupancy = m_occupancy.get();
+    context.planner = m_planner.get();
+    if (m_commander)
+        context.order = m_commander->order();
+    return context;
+}
+
 void Game::spawnPendingBullets()
 {
     while (!m_pendingBullets.empty()) {
@@ -249,7 +428,7 @@ void Game::spawnPendingBullets()
 
 int Game::rollBonusSpawnIntervalMs() const
 {
-    return QRandomGenerator::global()->bounded(kBonusSpawnIntervalMinMs, kBonusSpawnIntervalMaxMs + 1);
+    return m_random->bounded(kBonusSpawnIntervalMinMs, kBonusSpawnIntervalMaxMs + 1);
 }
 
 void Game::addScoreForBonus()
@@ -348,6 +527,10 @@ void Game::cleanupDestroyed(bool removeBullets)
             playerDestroyed = true;
         } else if (auto enemy = dynamic_cast<EnemyTank*>(tank)) {
             m_enemies.removeOne(enemy);
+            if (m_aiScheduler)
+                m_aiScheduler->removeAgent(enemy);
+            if (m_planner)
+                m_planner->releaseAgent(enemy);
             m_state.registerEnemyDestroyed();
             m_state.addScore(m_rules.scoreRules().enemyKill);
             onEnemyDestroyed(*enemy);
@@ -408,12 +591,16 @@ bool Game::trySpawnEnemy()
         auto enemy = std::make_unique<EnemyTank>(cell, type);
         enemy->setDirection(Direction::Down);
         enemy->setMap(m_map.get());
+        enemy->setOccupancy(m_occupancy.get());
         enemy->setFrozen(m_enemyFreezeTimerMs > 0);
+        enemy->setRandom(m_random.get());
 
         EnemyTank* enemyPtr = enemy.get();
         m_state.registerSpawnedEnemy();
         m_tanks.append(enemy.release());
         m_enemies.append(enemyPtr);
+        if (m_aiScheduler)
+            m_aiScheduler->addAgent(enemyPtr);
         return true;
     }
 
@@ -455,6 +642,10 @@ bool Game::canSpawnEnemyAt(const QPoint& cell) const
     if (tile.type != TileType::Empty)
         return false;
 
+    // танк, що саме в'їжджає у клітинку, вже тримає її в сітці зайнятості
+    if (m_occupancy && m_occupancy->occupant(cell))
+        return false;
+
     for (Tank* tank : m_tanks) {
         if (!tank)
             continue;
@@ -478,6 +669,12 @@ bool Game::canSpawnBonusAt(const QPoint& cell) const
     if (m_base && m_base->cell() == cell)
         return false;
 
+    // Бонус на острові, відрізаному від гравця стінами, не підібрати — поки цеглу не зруйновано.
+    // Потокову карту не перевіряємо: побудова областей підвантажила б її всю.
+    const QPoint playerCell = m_player ? m_player->cell() : m_playerSpawnCell;
+    if (!m_map->isStreamed() && !m_map->regions().connected(cell, playerCell))
+        return false;
+
     for (Tank* tank : m_tanks) {
         if (!tank)
             continue;
@@ -513,6 +710,9 @@ bool Game::canSpawnPlayerAt(const QPoint& cell) const
     if (!m_map->isWalkable(cell))
         return false;
 
+    if (m_occupancy && m_occupancy->occupant(cell))
+        return false;
+
     for (Tank* tank : m_tanks) {
         if (!tank)
             continue;
@@ -543,7 +743,7 @@ void Game::handleBonusCollection()
 
 std::unique_ptr<Bonus> Game::createRandomBonus(const QPoint& cell) const
 {
-    const int bonusRoll = QRandomGenerator::global()->bounded(4);
+    const int bonusRoll = m_random->bounded(4);
     switch (bonusRoll) {
     case 0:
         return std::make_unique<StarBonus>(cell);
@@ -565,18 +765,37 @@ void Game::trySpawnBonus()
     if (hasActiveBonus())
         return;
 
+    // Потокова карта: лише околиці гравця й бази, які й так тримаються в пам'яті,
+    // інакше перебір клітинок підвантажив би весь файл.
+    const QRect bounds(QPoint(0, 0), m_map->size());
+    QVector<QRect> areas;
+    if (m_map->isStreamed()) {
+        const QPoint margin(kStreamingRadiusCells, kStreamingRadiusCells);
+        const QPoint playerCell = m_player ? m_player->cell() : m_playerSpawnCell;
+        areas.append(QRect(playerCell - margin, playerCell + margin).intersected(bounds));
+        if (m_base)
+            areas.append(QRect(m_base->cell() - margin, m_base->cell() + margin).intersected(bounds));
+    } else {
+        areas.append(bounds);
+    }
+
     QList<QPoint> freeCells;
-    const QSize mapSize = m_map->size();
-    for (int y = 0; y < mapSize.height(); ++y) {
-        for (int x = 0; x < mapSize.width(); ++x) {
-            const QPoint cell(x, y);
-            if (canSpawnBonusAt(cell))
-                freeCells.append(cell);
+    for (qsizetype i = 0; i < areas.size(); ++i) {
+        const QRect& area = areas.at(i);
+        for (int y = area.top(); y <= area.bottom(); ++y) {
+            for (int x = area.left(); x <= area.right(); ++x) {
+                const QPoint cell(x, y);
+                // Клітинка зі спільної частини двох околиць рахується один раз.
+                if (i > 0 && areas.first().contains(cell))
+                    continue;
+                if (canSpawnBonusAt(cell))
+                    freeCells.append(cell);
+            }
         }
     }
 
     if (!freeCells.isEmpty()) {
-        const int index = QRandomGenerator::global()->bounded(freeCells.size());
+        const int index = m_random->bounded(freeCells.size());
         const QPoint spawnCell = freeCells.at(index);
 
         std::unique_ptr<Bonus> bonus = createRandomBonus(spawnCell);
@@ -679,6 +898,7 @@ void Game::trySpawnPlayer()
 
     auto player = std::make_unique<PlayerTank>(m_playerSpawnCell);
     player->setMap(m_map.get());
+    player->setOccupancy(m_occupancy.get());
     player->setInput(m_inputSystem);
 
     m_player = player.get();
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QList>
 #include <QPoint>
+#include <QRect>
 #include <optional>
 #include <vector>
 #include <memory>
@@ -19,10 +20,19 @@ class Bonus;
 class Bullet;
 class InputSystem;
 class LevelLoader;
+class LevelPreloader;
 class Map;
 class Base;
 class PhysicsSystem;
 class CollisionSystem;
+class AIScheduler;
+class CooperativePlanner;
+class EnemyCommander;
+class OccupancyGrid;
+class ThreatMap;
+class QRandomGenerator;
+class SessionRecording;
+struct AIContext;
 
 /*
  * Game — центральний фасад, який зшиває усі підсистеми разом.
@@ -44,6 +54,24 @@ public:
     void update(int deltaMs);
     void startNewGame();
     void setPendingLevelIndex(int index);
+    void setPendingLevelSeed(quint64 seed);
+    // Зерно генератора наступної партії: бонуси й рішення ворогів беруть випадковість
+    // лише з нього, тож партія повторюється за зерном і записаним вводом.
+    // Без явного зерна initialize() бере випадкове.
+    void setPendingSessionSeed(quint64 seed) { m_pendingSessionSeed = seed; }
+    quint64 sessionSeed() const { return m_sessionSeed; }
+    // Запис вводу по тіках; initialize() починає його заново для кожної партії.
+    void setRecording(SessionRecording* recording) { m_recording = recording; }
+    // Фонова підготовка рівня, поки відкрите меню; startNewGame() забере готову карту.
+    void preloadLevel(int index);
+    void preloadSavedLevel();
+    // Підготовка рівня, який перезапустить restart().
+    void preloadCurrentLevel();
+    std::optional<int> currentLevelIndex() const { return m_currentLevelIndex; }
+    std::optional<quint64> currentLevelSeed() const { return m_currentLevelSeed; }
+    // Клітинки в кадрі (Camera::visibleCells): потокова карта тримає їх у пам'яті разом з околицями танків.
+    void setViewCells(const QRect& cells) { m_viewCells = cells; }
+    bool hasNextLevel() const;
     void pause();
     void resume();
     void enterMainMenu();
@@ -66,9 +94,17 @@ public:
     void freezeEnemies(int durationMs);
     void detonateEnemies();
 
+    AIScheduler* aiScheduler() const { return m_aiScheduler.get(); }
+    const ThreatMap* threatMap() const { return m_threatMap.get(); }
+    const OccupancyGrid* occupancy() const { return m_occupancy.get(); }
+    const CooperativePlanner* planner() const { return m_planner.get(); }
+    const EnemyCommander* commander() const { return m_commander.get(); }
+
 private:
     void clearWorld();
     void updateTanks(int deltaMs);
+    void retainStreamedChunks();
+    AIContext buildAIContext() const;
     void updatePlayerRespawn(int deltaMs);
     void spawnPendingBullets();
     void updateBonuses(int deltaMs);
@@ -93,6 +129,7 @@ private:
     void setSessionState(GameSessionState state);
     void applyEnemyFreezeState();
     bool hasActiveBonus() const;
+    void reseedRandom();
 
     GameRules m_rules;
     GameState m_state;
@@ -100,6 +137,7 @@ private:
     std::unique_ptr<Map> m_map;
     std::unique_ptr<Base> m_base;
     std::unique_ptr<LevelLoader> m_levelLoader;
+    std::unique_ptr<LevelPreloader> m_levelPreloader;
 
     QList<Tank*> m_tanks;
     QList<EnemyTank*> m_enemies;
@@ -113,6 +151,11 @@ private:
 
     std::unique_ptr<PhysicsSystem> m_physicsSystem;
     std::unique_ptr<CollisionSystem> m_collisionSystem;
+    std::unique_ptr<AIScheduler> m_aiScheduler;
+    std::unique_ptr<ThreatMap> m_threatMap;
+    std::unique_ptr<OccupancyGrid> m_occupancy;
+    std::unique_ptr<CooperativePlanner> m_planner;
+    std::unique_ptr<EnemyCommander> m_commander;
 
     QList<QPoint> m_enemySpawnPoints;
     QPoint m_playerSpawnCell;
@@ -127,6 +170,15 @@ private:
     int m_enemyKillsSinceBonus = 0;
     int m_enemyFreezeTimerMs = 0;
     std::optional<int> m_pendingLevelIndex;
+    std::optional<int> m_currentLevelIndex;
+    std::optional<quint64> m_pendingLevelSeed;
+    std::optional<quint64> m_currentLevelSeed;
+    QRect m_viewCells;
+
+    std::unique_ptr<QRandomGenerator> m_random;
+    quint64 m_sessionSeed = 0;
+    std::optional<quint64> m_pendingSessionSeed;
+    SessionRecording* m_recording = nullptr;
 };
 
 #endif // GAME_H
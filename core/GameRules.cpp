@@ -29,3 +29,18 @@ void GameRules::setScoreRules(const ScoreRules& rules)
 {
     m_scoreRules = rules;
 }
+
+void GameRules::setEnemyCommanderEnabled(bool enabled)
+{
+    m_enemyCommanderEnabled = enabled;
+}
+
+void GameRules::setDeterministic(bool deterministic)
+{
+    m_deterministic = deterministic;
+}
+
+void GameRules::setPersistentWorld(bool persistent)
+{
+    m_persistentWorld = persistent;
+}
@@ -24,6 +24,13 @@ public:
     int totalWaves() const { return m_totalWaves; }
     QPoint baseCell() const { return m_baseCell; }
     const ScoreRules& scoreRules() const { return m_scoreRules; }
+    bool enemyCommanderEnabled() const { return m_enemyCommanderEnabled; }
+    // Детермінований режим для запису й відтворення сесій: ШІ без бюджету часу
+    // і без асинхронного EnemyCommander, тож перебіг залежить лише від зерна та вводу.
+    bool deterministic() const { return m_deterministic; }
+    // Постійний світ: зміни потокової карти (зруйнована цегла) записуються назад у файл рівня.
+    // Вимкнено за замовчуванням, щоб Restart, попереднє завантаження й утиліти бачили незмінний рівень.
+    bool persistentWorld() const { return m_persistentWorld; }
 
     void setMapSize(const QSize& size);
     void setPlayerLives(int lives);
@@ -31,6 +38,9 @@ public:
     void setTotalWaves(int waves);
     void setBaseCell(const QPoint& cell);
     void setScoreRules(const ScoreRules& rules);
+    void setEnemyCommanderEnabled(bool enabled);
+    void setDeterministic(bool deterministic);
+    void setPersistentWorld(bool persistent);
 
 private:
     QSize m_mapSize = QSize(32, 30);
@@ -39,6 +49,9 @@ private:
     int m_totalWaves = 5;
     QPoint m_baseCell = QPoint(15, 28);
     ScoreRules m_scoreRules;
+    bool m_enemyCommanderEnabled = false;
+    bool m_deterministic = false;
+    bool m_persistentWorld = false;
 };
 
 #endif // GAMERULES_H
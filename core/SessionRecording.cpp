@@ -0,0 +1,128 @@
+#include "core/SessionRecording.h"
+
+#include <QFile>
+#include <QtEndian>
+#include <cstring>
+
+#include "core/GameRules.h"
+
+namespace {
+constexpr char kMagic[4] = {'G', 'S', 'R', 'C'};
+
+// Зсуви полів заголовка.
+constexpr int kVersionOffset = 4;
+constexpr int kFlagsOffset = 6;
+constexpr int kLevelIndexOffset = 8;
+constexpr int kTickMsOffset = 12;
+constexpr int kLevelSeedOffset = 16;
+constexpr int kSessionSeedOffset = 24;
+constexpr int kWidthOffset = 32;
+constexpr int kHeightOffset = 34;
+constexpr int kBaseOffset = 36;
+constexpr int kTickCountOffset = 40;
+
+enum Flag : quint16 {
+    HasLevelIndex = 1 << 0,
+    HasLevelSeed = 1 << 1
+};
+
+bool fail(QString* error, const QString& message)
+{
+    if (error)
+        *error = message;
+    return false;
+}
+} // namespace
+
+void SessionRecording::start(const GameRules& rules, std::optional<int> levelIndex, std::optional<quint64> levelSeed,
+                             quint64 sessionSeed)
+{
+    m_levelIndex = levelIndex;
+    m_levelSeed = levelSeed;
+    m_sessionSeed = sessionSeed;
+    m_mapSize = rules.mapSize();
+    m_baseCell = rules.baseCell();
+    m_tickMs = 0;
+    m_inputs.clear();
+}
+
+void SessionRecording::appendTick(quint8 input, int deltaMs)
+{
+    if (m_inputs.isEmpty())
+        m_tickMs = deltaMs;
+    m_inputs.append(static_cast<char>(input));
+}
+
+void SessionRecording::clear()
+{
+    *this = SessionRecording();
+}
+
+void SessionRecording::applyTo(GameRules& rules) const
+{
+    if (!m_mapSize.isEmpty())
+        rules.setMapSize(m_mapSize);
+    rules.setBaseCell(m_baseCell);
+    rules.setDeterministic(true);
+}
+
+bool SessionRecording::save(const QString& filePath, QString* error) const
+{
+    QByteArray header(kHeaderSize, '\0');
+    char* data = header.data();
+    memcpy(data, kMagic, sizeof(kMagic));
+    quint16 flags = 0;
+    if (m_levelIndex.has_value())
+        flags |= HasLevelIndex;
+    if (m_levelSeed.has_value())
+        flags |= HasLevelSeed;
+    qToLittleEndian<quint16>(kVersion, data + kVersionOffset);
+    qToLittleEndian<quint16>(flags, data + kFlagsOffset);
+    qToLittleEndian<qint32>(m_levelIndex.value_or(-1), data + kLevelIndexOffset);
+    qToLittleEndian<quint16>(static_cast<quint16>(m_tickMs), data + kTickMsOffset);
+    qToLittleEndian<quint64>(m_levelSeed.value_or(0), data + kLevelSeedOffset);
+    qToLittleEndian<quint64>(m_sessionSeed, data + kSessionSeedOffset);
+    qToLittleEndian<quint16>(static_cast<quint16>(m_mapSize.width()), data + kWidthOffset);
+    qToLittleEndian<quint16>(static_cast<quint16>(m_mapSize.height()), data + kHeightOffset);
+    qToLittleEndian<qint16>(static_cast<qint16>(m_baseCell.x()), data + kBaseOffset);
+    qToLittleEndian<qint16>(static_cast<qint16>(m_baseCell.y()), data + kBaseOffset + 2);
+    qToLittleEndian<quint32>(static_cast<quint32>(m_inputs.size()), data + kTickCountOffset);
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return fail(error, file.errorString());
+    if (file.write(header) != header.size() || file.write(m_inputs) != m_inputs.size())
+        return fail(error, file.errorString());
+    return true;
+}
+
+bool SessionRecording::load(const QString& filePath, QString* error)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return fail(error, file.errorString());
+    const QByteArray bytes = file.readAll();
+    if (bytes.size() < kHeaderSize || memcmp(bytes.constData(), kMagic, sizeof(kMagic)) != 0)
+        return fail(error, QStringLiteral("not a session recording"));
+
+    const char* data = bytes.constData();
+    if (qFromLittleEndian<quint16>(data + kVersionOffset) != kVersion)
+        return fail(error, QStringLiteral("unsupported recording version"));
+    const quint32 tickCount = qFromLittleEndian<quint32>(data + kTickCountOffset);
+    if (bytes.size() - kHeaderSize != static_cast<qsizetype>(tickCount))
+        return fail(error, QStringLiteral("recording is truncated"));
+
+    const quint16 flags = qFromLittleEndian<quint16>(data + kFlagsOffset);
+    m_levelIndex.reset();
+    m_levelSeed.reset();
+    if (flags & HasLevelIndex)
+        m_levelIndex = qFromLittleEndian<qint32>(data + kLevelIndexOffset);
+    if (flags & HasLevelSeed)
+        m_levelSeed = qFromLittleEndian<quint64>(data + kLevelSeedOffset);
+    m_tickMs = qFromLittleEndian<quint16>(data + kTickMsOffset);
+    m_sessionSeed = qFromLittleEndian<quint64>(data + kSessionSeedOffset);
+    m_mapSize = QSize(qFromLittleEndian<quint16>(data + kWidthOffset), qFromLittleEndian<quint16>(data + kHeightOffset));
+    m_baseCell = QPoint(qFromLittleEndian<qint16>(data + kBaseOffset), qFromLittleEndian<qint16>(data + kBaseOffset + 2));
+    m_inputs = bytes.mid(kHeaderSize);
+    return true;
+}
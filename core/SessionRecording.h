@@ -0,0 +1,61 @@
+#ifndef SESSIONRECORDING_H
+#define SESSIONRECORDING_H
+
+#include <QByteArray>
+#include <QPoint>
+#include <QSize>
+#include <QString>
+#include <QtGlobal>
+#include <optional>
+
+class GameRules;
+
+/*
+ * SessionRecording — запис партії, достатній для її точного повторення:
+ * рівень (індекс або зерно генератора), зерно сесії Game, розмір поля, база,
+ * крок симуляції і по байту InputSystem::snapshot() на кожен тік.
+ * Повторення має сенс лише в детермінованому режимі GameRules.
+ * Файл *.gsrec: 44-байтний заголовок little-endian (magic "GSRC", версія, прапорці,
+ * поля вище, кількість тіків), далі байти вводу підряд — близько 200 КБ на годину гри.
+ */
+class SessionRecording
+{
+public:
+    static constexpr quint16 kVersion = 1;
+    static constexpr int kHeaderSize = 44;
+
+    static QString fileSuffix() { return QStringLiteral("gsrec"); }
+
+    // Починає запис нової партії, відкидаючи попередні тіки.
+    void start(const GameRules& rules, std::optional<int> levelIndex, std::optional<quint64> levelSeed, quint64 sessionSeed);
+    // Game крокує фіксованим тіком, тож крок береться з першого тіку.
+    void appendTick(quint8 input, int deltaMs);
+    void clear();
+
+    bool isEmpty() const { return m_inputs.isEmpty(); }
+    std::optional<int> levelIndex() const { return m_levelIndex; }
+    std::optional<quint64> levelSeed() const { return m_levelSeed; }
+    quint64 sessionSeed() const { return m_sessionSeed; }
+    QSize mapSize() const { return m_mapSize; }
+    QPoint baseCell() const { return m_baseCell; }
+    int tickMs() const { return m_tickMs; }
+    qsizetype tickCount() const { return m_inputs.size(); }
+    quint8 input(qsizetype tick) const { return static_cast<quint8>(m_inputs.at(tick)); }
+
+    // Налаштовує правила так само, як під час запису, включно з детермінованим режимом.
+    void applyTo(GameRules& rules) const;
+
+    bool save(const QString& filePath, QString* error = nullptr) const;
+    bool load(const QString& filePath, QString* error = nullptr);
+
+private:
+    std::optional<int> m_levelIndex;
+    std::optional<quint64> m_levelSeed;
+    quint64 m_sessionSeed = 0;
+    QSize m_mapSize;
+    QPoint m_baseCell;
+    int m_tickMs = 0;
+    QByteArray m_inputs;
+};
+
+#endif // SESSIONRECORDING_H
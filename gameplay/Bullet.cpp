@@ -70,6 +70,12 @@ void Bullet::destroy(bool spawnExplosion)
     m_alive = false;
 }
 
+qreal Bullet::msUntilNextCell() const
+{
+    const int remainingSubSteps = kStepsPerTile - m_subTileProgress;
+    return qMax<qreal>(0.0, remainingSubSteps * m_subStepIntervalMs - m_elapsedMs);
+}
+
 QPointF Bullet::visualTilePosition() const
 {
     if (kStepsPerTile <= 0)
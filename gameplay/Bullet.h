@@ -29,6 +29,8 @@ public:
     bool isAlive() const { return m_alive; }
     TankType type() const { return m_ownerType; }
     bool canPierceSteel() const { return m_canPierceSteel; }
+    int stepIntervalMs() const { return m_stepIntervalMs; }
+    qreal msUntilNextCell() const;
     QPointF renderPosition() const { return m_renderPositionCurrent; }
     QPointF previousRenderPosition() const { return m_renderPositionPrevious; }
     QPointF visualTilePosition() const;
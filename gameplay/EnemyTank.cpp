@@ -8,10 +8,6 @@
 #include "world/Map.h"
 #include "world/Tile.h"
 
-namespace {
-constexpr int kFireJitterMs = 200;
-} // namespace
-
 EnemyTank::EnemyTank(const QPoint& cell, EnemyType type)
     : Tank(cell)
     , m_enemyType(type)
@@ -20,7 +16,6 @@ EnemyTank::EnemyTank(const QPoint& cell, EnemyType type)
     setDirection(Direction::Down);
     setType(TankType::Enemy);
     applyStats();
-    resetFireInterval();
 }
 
 void EnemyTank::update()
@@ -41,40 +36,48 @@ void EnemyTank::updateWithDelta(int deltaMs)
     if (m_frozen)
         return;
 
-    m_moveElapsedMs += deltaMs;
-
-    m_fireElapsedMs += deltaMs;
-    if (m_fireElapsedMs >= m_fireIntervalMs) {
-        requestFire();
-        m_fireElapsedMs = 0;
-        resetFireInterval();
-    }
-
     if (stepIntervalMs() <= 0)
         return;
 
+    if (m_holdMs > 0 && isAlignedToGrid() && !m_sliding) {
+        m_holdMs = qMax(0, m_holdMs - deltaMs);
+        m_stepAccumulatorMs = 0;
+        return;
+    }
+
     m_stepAccumulatorMs += deltaMs;
 
     while (m_stepAccumulatorMs >= stepIntervalMs()) {
         m_stepAccumulatorMs -= stepIntervalMs();
 
-        const bool needsDirectionUpdate = isAlignedToGrid() && ((m_moveElapsedMs >= m_moveIntervalMs && !m_sliding) || !canMove(direction()));
-        if (needsDirectionUpdate) {
-            m_moveElapsedMs = 0;
-            tryMove();
+        if (isAlignedToGrid()) {
+            if (!m_sliding)
+                applyRequestedDirection();
+            if (!isTerrainOpen(direction()))
+                tryMove();
         }
 
-        const QPoint step = directionDelta();
-        const QPoint nextCell = cell() + step;
-        const bool canAdvance = (m_map && m_map->isWalkable(nextCell));
+        const QPoint nextCell = nextAlignedCell();
+        const bool terrainOpen = (m_map && m_map->isWalkable(nextCell));
+        const bool canAdvance = terrainOpen && claimNextCell(nextCell);
         if (!canAdvance) {
+            // Інший танк — тимчасова перешкода: коротко чекаємо, поки він звільнить
+            // клітинку (зазвичай він рухається за своїм резервуванням), і лише потім об'їжджаємо.
+            if (terrainOpen) {
+                m_tankWaitMs += stepIntervalMs();
+                if (m_tankWaitMs >= kMaxTankWaitMs) {
+                    m_tankWaitMs = 0;
+                    tryMove();
+                }
+            }
+            releaseNextCell();
             m_stepAccumulatorMs = 0;
             m_subTileProgress = 0;
             m_sliding = false;
             updateRenderPosition(direction());
-            m_moveElapsedMs = m_moveIntervalMs; // force new direction check on next aligned tick
             break;
         }
+        m_tankWaitMs = 0;
 
         ++m_subTileProgress;
         updateRenderPosition(direction());
@@ -86,6 +89,11 @@ void EnemyTank::updateWithDelta(int deltaMs)
     }
 }
 
+QPoint EnemyTank::nextAlignedCell() const
+{
+    return cell() + directionDelta();
+}
+
 QPoint EnemyTank::directionDelta() const
 {
     return Tank::directionDelta(direction());
@@ -105,9 +113,9 @@ bool EnemyTank::receiveDamage(int dmg)
     return damaged;
 }
 
-Direction EnemyTank::oppositeDirection() const
+Direction EnemyTank::oppositeDirection(Direction direction)
 {
-    switch (direction()) {
+    switch (direction) {
     case Direction::Up:    return Direction::Down;
     case Direction::Down:  return Direction::Up;
     case Direction::Left:  return Direction::Right;
@@ -116,23 +124,12 @@ Direction EnemyTank::oppositeDirection() const
     return Direction::Down;
 }
 
-Direction EnemyTank::randomDirection(Direction exclude) const
+bool EnemyTank::canMove(Direction direction) const
 {
-    Direction newDirection = direction();
-    do {
-        const int value = QRandomGenerator::global()->bounded(4);
-        switch (value) {
-        case 0: newDirection = Direction::Up; break;
-        case 1: newDirection = Direction::Down; break;
-        case 2: newDirection = Direction::Left; break;
-        case 3: newDirection = Direction::Right; break;
-        }
-    } while (newDirection == exclude);
-
-    return newDirection;
+    return isTerrainOpen(direction) && isCellFreeOfTanks(cell() + directionDelta(direction));
 }
 
-bool EnemyTank::canMove(Direction direction) const
+bool EnemyTank::isTerrainOpen(Direction direction) const
 {
     if (!m_map)
         return false;
@@ -157,8 +154,24 @@ bool EnemyTank::shouldSlide() const
     return m_map->isWalkable(nextCell);
 }
 
+void EnemyTank::applyRequestedDirection()
+{
+    if (!m_requestedDirection.has_value())
+        return;
+
+    const Direction requested = *m_requestedDirection;
+    m_requestedDirection.reset();
+    if (requested == direction() || !canMove(requested))
+        return;
+
+    setDirection(requested);
+    m_sliding = shouldSlide();
+}
+
 void EnemyTank::tryMove()
 {
+    // Аварійний обхід перешкоди: дешевий і виконується одразу,
+    // щоби танк не стояв у стіні, поки планувальник дійде до його черги.
     if (!m_map)
         return;
 
@@ -172,33 +185,20 @@ void EnemyTank::tryMove()
     if (availableDirections.isEmpty())
         return;
 
-    Direction current = direction();
-    const bool blocked = !canMove(current);
-    if (blocked || QRandomGenerator::global()->bounded(100) < 25) {
-        QVector<Direction> candidates = availableDirections;
-
-        // уникаємо розворотів на 180 градусів, якщо є інші опції
-        const Direction opposite = oppositeDirection();
-        if (candidates.size() > 1)
-            candidates.removeOne(opposite);
-
-        if (!candidates.isEmpty())
-            current = candidates.at(QRandomGenerator::global()->bounded(candidates.size()));
-        else
-            current = opposite;
-        setDirection(current);
-    }
+    QVector<Direction> candidates = availableDirections;
+
+    // уникаємо розворотів на 180 градусів, якщо є інші опції
+    const Direction opposite = oppositeDirection(direction());
+    if (candidates.size() > 1)
+        candidates.removeOne(opposite);
 
-    setDirection(current);
+    setDirection(candidates.at(random()->bounded(candidates.size())));
     m_sliding = shouldSlide();
 }
 
-void EnemyTank::resetFireInterval()
+QRandomGenerator* EnemyTank::random() const
 {
-    const int jitter = qMax(0, kFireJitterMs);
-    const int minInterval = qMax(50, m_stats.fireCooldownMs - jitter);
-    const int maxInterval = m_stats.fireCooldownMs + jitter + 1;
-    m_fireIntervalMs = QRandomGenerator::global()->bounded(minInterval, maxInterval);
+    return m_random ? m_random : QRandomGenerator::global();
 }
 
 void EnemyTank::triggerHitFeedback()
@@ -211,7 +211,6 @@ void EnemyTank::applyStats()
 {
     const float tilesPerSecond = tilesPerSecondFromStats(m_stats);
     setSpeed(tilesPerSecond);
-    m_fireIntervalMs = m_stats.fireCooldownMs;
     m_weapon.setReloadTime(m_stats.fireCooldownMs);
 
     m_health.setMaxHealth(m_stats.armorHits);
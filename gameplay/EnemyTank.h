@@ -2,9 +2,11 @@
 #define ENEMYTANK_H
 
 #include <QColor>
+#include <optional>
 #include "gameplay/Tank.h"
 
 class Map;
+class QRandomGenerator;
 
 struct EnemyStats
 {
@@ -18,16 +20,26 @@ struct EnemyStats
 };
 
 /*
- * EnemyTank — примітивний супротивник, який стріляє за таймером.
+ * EnemyTank — супротивник, що сам виконує лише дешеве кермування:
+ * рух по клітинках, ковзання та обхід перешкоди.
+ * Рішення про поворот і постріл приходять ззовні (EnemyAI через AIScheduler).
  */
 class EnemyTank : public Tank
 {
 public:
+    // Скільки танк чекає перед іншим танком, перш ніж шукати об'їзд.
+    static constexpr int kMaxTankWaitMs = 600;
+
     EnemyTank(const QPoint& cell, EnemyType type = EnemyType::Basic);
 
     void setMap(const Map* map) { m_map = map; }
+    const Map* map() const { return m_map; }
     void setFrozen(bool frozen) { m_frozen = frozen; }
     bool isFrozen() const { return m_frozen; }
+    // Генератор сесії Game: з ним рух і стрільба відтворюються з того ж зерна.
+    // Без нього (nullptr) береться QRandomGenerator::global().
+    void setRandom(QRandomGenerator* random) { m_random = random; }
+    QRandomGenerator* random() const;
 
     void update() override;
     void updateWithDelta(int deltaMs) override;
@@ -42,30 +54,39 @@ public:
     bool dropsBonus() const { return m_stats.dropsBonus; }
     QColor currentColor() const;
 
+    // Запит застосовується на найближчій вирівняній клітинці, якщо напрямок прохідний.
+    void requestDirection(Direction direction) { m_requestedDirection = direction; }
+    // Постояти на вирівняній клітинці, поки інший танк проїде зарезервований слот.
+    void requestHold(int durationMs) { m_holdMs = qMax(m_holdMs, durationMs); }
+    // Прохідність з урахуванням інших танків (сітка зайнятості).
+    bool canMove(Direction direction) const;
+    QPoint nextAlignedCell() const;
+    // Клітинка, на якій буде застосовано наступний запит напрямку.
+    QPoint decisionCell() const { return isAlignedToGrid() ? cell() : nextAlignedCell(); }
+    bool isSliding() const { return m_sliding; }
+    static Direction oppositeDirection(Direction direction);
+
 private:
     QPoint directionDelta() const;
     QPoint directionDelta(Direction direction) const;
-    Direction oppositeDirection() const;
-    Direction randomDirection(Direction exclude) const;
-    bool canMove(Direction direction) const;
     bool shouldSlide() const;
+    bool isTerrainOpen(Direction direction) const;
+    void applyRequestedDirection();
     void tryMove();
-    void resetFireInterval();
     void applyStats();
     static const EnemyStats& statsForType(EnemyType type);
     static float tilesPerSecondFromStats(const EnemyStats& stats);
 
     const Map* m_map = nullptr;
+    QRandomGenerator* m_random = nullptr;
     EnemyType m_enemyType = EnemyType::Basic;
     EnemyStats m_stats;
 
-    int m_fireElapsedMs = 0;
-    int m_fireIntervalMs = 1000;
-
-    int m_moveElapsedMs = 0;
-    int m_moveIntervalMs = 600;
+    std::optional<Direction> m_requestedDirection;
 
     int m_hitFeedbackTimerMs = 0;
+    int m_tankWaitMs = 0;
+    int m_holdMs = 0;
     bool m_sliding = false;
     bool m_frozen = false;
 };
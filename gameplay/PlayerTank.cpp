@@ -101,8 +101,9 @@ void PlayerTank::updateWithDelta(int deltaMs)
         const QPoint step = Tank::directionDelta(direction());
         const QPoint nextCell = cell() + step;
 
-        const bool canAdvance = (!m_map || m_map->isWalkable(nextCell));
+        const bool canAdvance = (!m_map || m_map->isWalkable(nextCell)) && claimNextCell(nextCell);
         if (!canAdvance) {
+            releaseNextCell();
             m_stepAccumulatorMs = 0;
             m_subTileProgress = 0;
             m_sliding = false;
@@ -144,7 +145,7 @@ int PlayerTank::reloadTimeMs() const
     if (m_stars >= 2)
         return 250;
 
-    return 400;
+    return kDefaultReloadMs;
 }
 
 bool PlayerTank::receiveDamage(int dmg)
@@ -1,6 +1,7 @@
 #include "gameplay/Tank.h"
 
 #include "gameplay/Bullet.h"
+#include "world/OccupancyGrid.h"
 #include <QtGlobal>
 
 namespace {
@@ -14,11 +15,16 @@ Tank::Tank(const QPoint& cell)
 {
     m_health.setMaxHealth(1);
     m_health.setLives(1);
-    m_weapon.setReloadTime(400);
+    m_weapon.setReloadTime(kDefaultReloadMs);
     setSpeed(m_speed);
     syncRenderPositions(true);
 }
 
+Tank::~Tank()
+{
+    releaseOccupiedCells();
+}
+
 TankType Tank::getType()
 {
     return m_type;
@@ -42,6 +48,8 @@ void Tank::markDestroyed()
 
     m_destroyed = true;
     m_destructionTimerMs = kDestructionDelayMs;
+    // уламки не блокують проїзд
+    releaseOccupiedCells();
 }
 
 void Tank::update()
@@ -75,11 +83,60 @@ int Tank::stepIntervalMsForSpeed(float speed) const
 
 void Tank::setCell(const QPoint& cell)
 {
+    if (m_occupancy && !m_destroyed) {
+        m_occupancy->release(m_cell, this);
+        m_occupancy->claim(cell, this);
+    }
+    m_claimedNextCell.reset();
+
     m_cell = cell;
     syncRenderPositions(false);
     resetSubTileProgress();
 }
 
+void Tank::setOccupancy(OccupancyGrid* occupancy)
+{
+    releaseOccupiedCells();
+    m_occupancy = occupancy;
+    if (m_occupancy && !m_destroyed)
+        m_occupancy->claim(m_cell, this);
+}
+
+bool Tank::isCellFreeOfTanks(const QPoint& cell) const
+{
+    return !m_occupancy || m_occupancy->isFreeFor(cell, this);
+}
+
+bool Tank::claimNextCell(const QPoint& cell)
+{
+    if (!m_occupancy)
+        return true;
+
+    if (m_claimedNextCell == cell)
+        return true;
+
+    releaseNextCell();
+    if (!m_occupancy->claim(cell, this))
+        return false;
+
+    m_claimedNextCell = cell;
+    return true;
+}
+
+void Tank::releaseNextCell()
+{
+    if (m_occupancy && m_claimedNextCell.has_value())
+        m_occupancy->release(*m_claimedNextCell, this);
+    m_claimedNextCell.reset();
+}
+
+void Tank::releaseOccupiedCells()
+{
+    releaseNextCell();
+    if (m_occupancy)
+        m_occupancy->release(m_cell, this);
+}
+
 void Tank::resetSubTileProgress()
 {
     m_subTileProgress = 0;
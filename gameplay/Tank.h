@@ -4,6 +4,7 @@
 #include <QPoint>
 #include <QPointF>
 #include <memory>
+#include <optional>
 
 #include "gameplay/Direction.h"
 #include "gameplay/GameObject.h"
@@ -13,6 +14,7 @@
 #include "enums/enums.h"
 
 class Bullet;
+class OccupancyGrid;
 
 /*
  * Tank — базовий клас, що описує спільні властивості танків
@@ -25,8 +27,11 @@ private:
 
 public:
 
+    // Перезарядка гравця без зірок; симуляції ШІ беруть її ж.
+    static constexpr int kDefaultReloadMs = 400;
+
     explicit Tank(const QPoint& cell);
-    virtual ~Tank() = default;
+    virtual ~Tank();
 
     TankType getType();
     static QPoint directionDelta(Direction dir);
@@ -41,11 +46,17 @@ public:
     QPointF previousRenderPosition() const { return m_renderPositionPrevious; }
     void setCell(const QPoint& cell);
 
+    // Сітка зайнятості спільна для всіх танків рівня; танк тримає свою клітинку
+    // та клітинку, в яку саме в'їжджає.
+    void setOccupancy(OccupancyGrid* occupancy);
+    bool isCellFreeOfTanks(const QPoint& cell) const;
+
     Direction direction() const { return m_direction; }
     void setDirection(Direction dir) { m_direction = dir; }
 
     float speed() const { return m_speed; }
     void setSpeed(float speed);
+    int msPerTile() const { return m_stepIntervalMs * kStepsPerTile; }
 
     HealthSystem& health() { return m_health; }
     const HealthSystem& health() const { return m_health; }
@@ -70,8 +81,9 @@ protected:
     void resetSubTileProgress();
     void updateRenderPosition(Direction dir);
     void syncRenderPositions(bool resetPrevious = true);
-
-
+    bool claimNextCell(const QPoint& cell);
+    void releaseNextCell();
+    void releaseOccupiedCells();
 
     Direction m_direction = Direction::Up;
     float m_speed = kDefaultTilesPerSecond;
@@ -80,6 +92,9 @@ protected:
     QPointF m_renderPositionCurrent;
     QPointF m_renderPositionPrevious;
 
+    OccupancyGrid* m_occupancy = nullptr;
+    std::optional<QPoint> m_claimedNextCell;
+
     int m_stepIntervalMs = 0;
     int m_stepAccumulatorMs = 0;
     int m_subTileProgress = 0;
@@ -12,8 +12,10 @@
 #include "mainwindow.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
 
-
+#include "rendering/RenderBackend.h"
 
 int main(int argc, char *argv[])
 {
@@ -27,7 +29,45 @@ int main(int argc, char *argv[])
 #endif
 
     QApplication a(argc, argv);
-    MainWindow w;
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption rendererOption(QStringList() << QStringLiteral("renderer"),
+                                            QStringLiteral("Render backend: scene (default) or raster."),
+                                            QStringLiteral("backend"),
+                                            QStringLiteral("scene"));
+    parser.addOption(rendererOption);
+    const QCommandLineOption recordOption(QStringList() << QStringLiteral("record"),
+                                          QStringLiteral("Record the last played session to <file> for tools/framedump --replay."),
+                                          QStringLiteral("file"));
+    parser.addOption(recordOption);
+    const QCommandLineOption pixelTileOption(QStringList() << QStringLiteral("pixel-tile"),
+                                             QStringLiteral("Render the playfield at about <px> pixels per tile and upscale it "
+                                                            "by a whole factor with nearest-neighbour (implies raster)."),
+                                             QStringLiteral("px"));
+    parser.addOption(pixelTileOption);
+    parser.process(a);
+
+    RenderSettings renderSettings;
+    const QString backend = parser.value(rendererOption);
+    if (backend == QLatin1String("raster")) {
+        renderSettings.backend = RenderBackendKind::Raster;
+    } else if (backend != QLatin1String("scene")) {
+        QTextStream(stderr) << "Unknown renderer: " << backend << Qt::endl;
+        return 1;
+    }
+    if (parser.isSet(pixelTileOption)) {
+        bool ok = false;
+        renderSettings.pixelTileSize = parser.value(pixelTileOption).toInt(&ok);
+        if (!ok || renderSettings.pixelTileSize <= 0) {
+            QTextStream(stderr) << "Invalid pixel tile size: " << parser.value(pixelTileOption) << Qt::endl;
+            return 1;
+        }
+    }
+
+    MainWindow w(renderSettings);
+    if (parser.isSet(recordOption))
+        w.setRecordingPath(parser.value(recordOption));
     w.showFullScreen();
     return a.exec();
 }
@@ -8,19 +8,25 @@
 #include <QSize>
 #include <QResizeEvent>
 #include <QtGlobal>
+#include <QDebug>
 #include <QMouseEvent>
-#include <algorithm>
+#include <utility>
 
 #include "LevelEditor.h"
 #include "core/Game.h"
+#include "core/SessionRecording.h"
 #include "systems/InputSystem.h"
 #include "systems/MenuSystem.h"
+#include "rendering/Camera.h"
 #include "rendering/Renderer.h"
 #include "rendering/EditorOverlayItem.h"
+#include "rendering/RasterRenderBackend.h"
+#include "rendering/RenderLayout.h"
+#include "rendering/SceneRenderBackend.h"
+#include "rendering/SpriteManager.h"
 #include "utils/Constants.h"
-#include "world/Map.h"
 
-MainWindow::MainWindow(QWidget *parent)
+MainWindow::MainWindow(const RenderSettings& renderSettings, QWidget *parent)
     : QMainWindow(parent)
 {
     /* =====================
@@ -29,7 +35,15 @@ MainWindow::MainWindow(QWidget *parent)
 
     m_scene = new QGraphicsScene(this);
 
-    m_view = new QGraphicsView(m_scene, this);
+    // Растровий вид малює поле у фоні сам; на сцені лишаються тільки меню й редактор.
+    RasterGameView* rasterView = nullptr;
+    // Збільшення кадру низької роздільності вміє лише растровий бекенд.
+    if (renderSettings.backend == RenderBackendKind::Raster || renderSettings.pixelTileSize > 0) {
+        rasterView = new RasterGameView(m_scene, this);
+        m_view = rasterView;
+    } else {
+        m_view = new QGraphicsView(m_scene, this);
+    }
     m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     m_view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     setCentralWidget(m_view);
@@ -57,10 +71,32 @@ MainWindow::MainWindow(QWidget *parent)
     m_menuSystem->setExitCallback([this]() { close(); });
     m_menuSystem->showMainMenu();
 
-    m_renderer = std::make_unique<Renderer>(m_scene);
+    std::unique_ptr<RenderBackend> backend;
+    if (rasterView)
+        backend = std::make_unique<RasterRenderBackend>(rasterView);
+    else
+        backend = std::make_unique<SceneRenderBackend>(m_scene);
+    m_renderer = std::make_unique<Renderer>(std::move(backend));
+    // Геометрія кадру перераховується з resizeEvent, а не щокадру.
+    m_layout = std::make_unique<RenderLayout>();
+    m_layout->setPixelTileSize(renderSettings.pixelTileSize);
+    updateLayout();
+    m_renderer->setLayout(m_layout.get());
+    m_camera = std::make_unique<Camera>();
+    m_renderer->setCamera(m_camera.get());
+
+    // Аркуші декодуються у фоні, поки відкрите меню; до того поле малюється процедурно.
+    m_sprites = std::make_unique<SpriteManager>();
+    QString spriteError;
+    if (!m_sprites->loadManifest(SpriteManager::defaultManifestPath(), &spriteError))
+        qWarning() << "Sprite manifest:" << spriteError;
+    m_sprites->loadAsync();
+    m_renderer->setSpriteManager(m_sprites.get());
     m_levelEditor = std::make_unique<LevelEditor>();
     m_levelEditor->setGame(m_game.get());
     m_levelEditor->setView(m_view);
+    m_levelEditor->setLayout(m_layout.get());
+    m_levelEditor->setCamera(m_camera.get());
 
     m_editorOverlay = new EditorOverlayItem();
     m_editorOverlay->setVisible(false);
@@ -68,6 +104,7 @@ MainWindow::MainWindow(QWidget *parent)
         if (m_levelEditor)
             m_levelEditor->setSelectedTile(type);
     });
+    m_editorOverlay->setPos(12.0, 12.0);
     m_scene->addItem(m_editorOverlay);
 
     /* =====================
@@ -90,9 +127,13 @@ MainWindow::MainWindow(QWidget *parent)
             m_menuSystem->syncWithGameState(m_game->state());
 
         const qreal alpha = static_cast<qreal>(m_frameAccumulatorMs) / static_cast<qreal>(kFixedTickMs);
+        if (m_camera)
+            m_camera->advance(static_cast<qreal>(frameDeltaMs));
 
         if (m_renderer)
             m_renderer->renderFrame(*m_game, alpha);
+        if (m_camera && m_game)
+            m_game->setViewCells(m_camera->visibleCells());
 
         if (m_menuSystem)
             m_menuSystem->renderMenus();
@@ -105,6 +146,20 @@ MainWindow::MainWindow(QWidget *parent)
 MainWindow::~MainWindow()
 {
     // Qt удалит QObject-детей автоматически
+    if (m_recording && !m_recording->isEmpty()) {
+        QString error;
+        if (!m_recording->save(m_recordingPath, &error))
+            qWarning() << "Failed to save session recording" << m_recordingPath << ":" << error;
+    }
+}
+
+void MainWindow::setRecordingPath(const QString& filePath)
+{
+    m_recordingPath = filePath;
+    if (!m_recording)
+        m_recording = std::make_unique<SessionRecording>();
+    m_game->rules().setDeterministic(true);
+    m_game->setRecording(m_recording.get());
 }
 
 void MainWindow::keyPressEvent(QKeyEvent *event)
@@ -130,7 +185,7 @@ void MainWindow::keyPressEvent(QKeyEvent *event)
         return;
     }
 
-    if (m_input && m_input->handleKeyPress(event->key(), event->nativeScanCode())) {
+    if (handleZoomKey(event->key()) || (m_input && m_input->handleKeyPress(event->key(), event->nativeScanCode()))) {
         event->accept();
         return;
     }
@@ -181,8 +236,32 @@ void MainWindow::resizeEvent(QResizeEvent *event)
 {
     QMainWindow::resizeEvent(event);
 
+    updateLayout();
+    // Меню перекладається в наступному кадрі, коли бекенд уже оновить розмір сцени.
     if (m_menuSystem)
-        m_menuSystem->renderMenus();
+        m_menuSystem->invalidateLayout();
+}
+
+bool MainWindow::handleZoomKey(int key)
+{
+    if (!m_camera)
+        return false;
+
+    // +/− наближають і віддаляють, 0 повертає початковий масштаб.
+    switch (key) {
+    case Qt::Key_Plus:
+    case Qt::Key_Equal:
+        m_camera->zoomBy(kZoomStep);
+        return true;
+    case Qt::Key_Minus:
+        m_camera->zoomBy(1.0 / kZoomStep);
+        return true;
+    case Qt::Key_0:
+        m_camera->setZoom(1.0);
+        return true;
+    default:
+        return false;
+    }
 }
 
 void MainWindow::updateEditorOverlay()
@@ -198,20 +277,14 @@ void MainWindow::updateEditorOverlay()
     if (m_levelEditor)
         m_editorOverlay->setSelectedTile(m_levelEditor->selectedTile());
 
-    qreal tileSize = 26.0;
-    if (m_view && m_view->viewport() && m_game) {
-        Map* map = m_game->map();
-        if (map) {
-            const QSize viewportSize = m_view->viewport()->size();
-            const QSize mapSize = map->size();
-            if (!viewportSize.isEmpty() && !mapSize.isEmpty()) {
-                const qreal widthScale = static_cast<qreal>(viewportSize.width()) / static_cast<qreal>(mapSize.width());
-                const qreal heightScale = static_cast<qreal>(viewportSize.height()) / static_cast<qreal>(mapSize.height());
-                tileSize = qBound<qreal>(18.0, std::min(widthScale, heightScale), 56.0);
-            }
-        }
+    if (m_layout && m_layout->version() != m_editorLayoutVersion) {
+        m_editorLayoutVersion = m_layout->version();
+        m_editorOverlay->setTileSize(m_layout->editorTileSize());
     }
+}
 
-    m_editorOverlay->setTileSize(tileSize);
-    m_editorOverlay->setPos(12.0, 12.0);
+void MainWindow::updateLayout()
+{
+    if (m_layout && m_view && m_view->viewport())
+        m_layout->setViewportSize(m_view->viewport()->size());
 }
@@ -3,8 +3,11 @@
 
 #include <QMainWindow>
 #include <QElapsedTimer>
+#include <QString>
 #include <memory>
 
+#include "rendering/RenderBackend.h"
+
 class QGraphicsScene;
 class QGraphicsView;
 class QTimer;
@@ -13,9 +16,13 @@ class QMouseEvent;
 class QResizeEvent;
 
 class Game;
+class SessionRecording;
 class InputSystem;
 class MenuSystem;
+class Camera;
 class Renderer;
+class RenderLayout;
+class SpriteManager;
 class LevelEditor;
 class EditorOverlayItem;
 
@@ -24,9 +31,13 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget *parent = nullptr);
+    explicit MainWindow(const RenderSettings& renderSettings = RenderSettings(), QWidget *parent = nullptr);
     ~MainWindow();
 
+    // Вмикає детермінований режим і записує ввід кожної партії; остання партія
+    // зберігається у filePath при закритті вікна (див. tools/framedump --replay).
+    void setRecordingPath(const QString& filePath);
+
 protected:
     void keyPressEvent(QKeyEvent *event) override;
     void keyReleaseEvent(QKeyEvent *event) override;
@@ -35,19 +46,28 @@ protected:
 
 private:
     static constexpr int kFixedTickMs = 16;
+    static constexpr qreal kZoomStep = 1.25;
     void updateEditorOverlay();
+    bool handleZoomKey(int key);
+    void updateLayout();
 
     // View / Scene
     QGraphicsScene* m_scene = nullptr;
     QGraphicsView* m_view = nullptr;
 
     // Game
+    std::unique_ptr<SessionRecording> m_recording;
+    QString m_recordingPath;
     std::unique_ptr<Game> m_game;
     std::unique_ptr<InputSystem> m_input;
     std::unique_ptr<MenuSystem> m_menuSystem;
+    std::unique_ptr<SpriteManager> m_sprites;
+    std::unique_ptr<RenderLayout> m_layout;
+    std::unique_ptr<Camera> m_camera;
     std::unique_ptr<Renderer> m_renderer;
     std::unique_ptr<LevelEditor> m_levelEditor;
     EditorOverlayItem* m_editorOverlay = nullptr;
+    quint64 m_editorLayoutVersion = 0;
 
     // Timer
     QTimer* m_timer = nullptr;
@@ -1,6 +1,96 @@
 #include "rendering/Camera.h"
 
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Дрібніше тайли не зменшуються, навіть якщо вся велика карта тоді не вміщується.
+constexpr qreal kMinTilePixels = 20.0;
+constexpr qreal kMinZoom = 0.25;
+constexpr qreal kMaxZoom = 4.0;
+// За цей час камера проходить ~63% відстані до цілі.
+constexpr qreal kFollowTimeMs = 120.0;
+
+// Центр по одній осі: карта менша за кадр — посередині, інакше не далі краю.
+qreal clampAxis(qreal center, qreal mapTiles, qreal visibleTiles)
+{
+    if (mapTiles <= visibleTiles)
+        return mapTiles / 2.0;
+    return qBound(visibleTiles / 2.0, center, mapTiles - visibleTiles / 2.0);
+}
+} // namespace
+
+void Camera::setViewport(const QSize& viewport, const QSize& map, qreal fitTileSize)
+{
+    if (viewport == m_viewport && map == m_map && qFuzzyCompare(fitTileSize, m_fitTileSize))
+        return;
+    m_viewport = viewport;
+    m_map = map;
+    m_fitTileSize = fitTileSize;
+    setZoom(m_zoom);
+    snapToTarget();
+}
+
+void Camera::snapToTarget()
+{
+    m_center = clampedCenter(m_target);
+    updateOffset();
+}
+
+void Camera::advance(qreal elapsedMs)
+{
+    if (elapsedMs <= 0.0)
+        return;
+    const QPointF goal = clampedCenter(m_target);
+    const qreal t = 1.0 - std::exp(-elapsedMs / kFollowTimeMs);
+    m_center += (goal - m_center) * t;
+    updateOffset();
+}
+
+void Camera::setZoom(qreal zoom)
+{
+    m_zoom = qBound(kMinZoom, zoom, kMaxZoom);
+    // Масштаб ніколи не робить карту меншою за вікно: далі віддаляти нема куди.
+    m_tileSize = std::max(m_fitTileSize, std::max(m_fitTileSize, kMinTilePixels) * m_zoom);
+    m_center = clampedCenter(m_center);
+    updateOffset();
+}
+
+QRect Camera::visibleCells(int margin) const
+{
+    if (m_map.isEmpty() || m_tileSize <= 0.0)
+        return QRect();
+    const QPointF topLeft = toTile(QPointF(0.0, 0.0));
+    const QPointF bottomRight = toTile(QPointF(m_viewport.width(), m_viewport.height()));
+    const int left = std::max(0, static_cast<int>(std::floor(topLeft.x())) - margin);
+    const int top = std::max(0, static_cast<int>(std::floor(topLeft.y())) - margin);
+    const int right = std::min(m_map.width() - 1, static_cast<int>(std::ceil(bottomRight.x())) + margin);
+    const int bottom = std::min(m_map.height() - 1, static_cast<int>(std::ceil(bottomRight.y())) + margin);
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
 QPointF Camera::toScene(const QPointF& worldPos) const
 {
-    return QPointF(worldPos.x() * m_tileSize, worldPos.y() * m_tileSize);
+    return m_offset + worldPos * m_tileSize;
+}
+
+QPointF Camera::toTile(const QPointF& scenePos) const
+{
+    return (scenePos - m_offset) / m_tileSize;
+}
+
+QPointF Camera::clampedCenter(const QPointF& center) const
+{
+    if (m_tileSize <= 0.0)
+        return center;
+    return QPointF(clampAxis(center.x(), m_map.width(), m_viewport.width() / m_tileSize),
+                   clampAxis(center.y(), m_map.height(), m_viewport.height() / m_tileSize));
+}
+
+void Camera::updateOffset()
+{
+    // Ціле зміщення: при прокрутці тайли не тремтять на дробових пікселях.
+    const QPointF offset = QPointF(m_viewport.width(), m_viewport.height()) / 2.0 - m_center * m_tileSize;
+    m_offset = QPointF(std::round(offset.x()), std::round(offset.y()));
 }
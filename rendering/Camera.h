@@ -2,20 +2,54 @@
 #define CAMERA_H
 
 #include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <QSize>
 
 /*
  * Camera конвертує координати світу у координати сцени.
+ * Розмір тайла — найбільший із «вписати всю карту» та мінімального читабельного,
+ * помножений на масштаб; малі карти, як і раніше, видно цілком. Якщо карта
+ * більша за вікно, камера плавно (експоненційно, frame-rate незалежно) йде за
+ * ціллю — зазвичай гравцем — і не виходить за край карти. visibleCells() дає
+ * прямокутник клітинок у кадрі, щоби Renderer не збирав того, чого не видно.
  */
 class Camera
 {
 public:
-    void setTileSize(qreal size) { m_tileSize = size; }
+    // viewport — пікселі вікна, map — клітинки, fitTileSize — тайл, з яким карта вміщується цілком.
+    void setViewport(const QSize& viewport, const QSize& map, qreal fitTileSize);
+    // Точка світу (у тайлах), яку камера тримає в центрі кадру.
+    void setTarget(const QPointF& tile) { m_target = tile; }
+    // Одразу в ціль, без згладжування: новий рівень чи зміна розміру вікна.
+    void snapToTarget();
+    void advance(qreal elapsedMs);
+
+    void setZoom(qreal zoom);
+    void zoomBy(qreal factor) { setZoom(m_zoom * factor); }
+    qreal zoom() const { return m_zoom; }
+
     qreal tileSize() const { return m_tileSize; }
+    // Пікселі сцени, де лежить кут клітинки (0, 0).
+    QPointF offset() const { return m_offset; }
+    // Клітинки, що хоч частково в кадрі, з запасом margin, обрізані картою.
+    QRect visibleCells(int margin = 0) const;
 
     QPointF toScene(const QPointF& worldPos) const;
+    QPointF toTile(const QPointF& scenePos) const;
 
 private:
+    QPointF clampedCenter(const QPointF& center) const;
+    void updateOffset();
+
+    QSize m_viewport;
+    QSize m_map;
+    qreal m_fitTileSize = 32.0;
+    qreal m_zoom = 1.0;
     qreal m_tileSize = 32.0;
+    QPointF m_target;
+    QPointF m_center;
+    QPointF m_offset;
 };
 
 #endif // CAMERA_H
@@ -0,0 +1,56 @@
+#include "rendering/DrawBatchItem.h"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+
+#include "rendering/DrawListPainter.h"
+
+DrawBatchItem::DrawBatchItem()
+{
+    setAcceptedMouseButtons(Qt::NoButton);
+    setAcceptHoverEvents(false);
+    setFlag(QGraphicsItem::ItemIsFocusable, false);
+    // exposedRect дає змогу пропускати прямокутники поза оновлюваною областю.
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+void DrawBatchItem::commit()
+{
+    const auto byDepth = [](const DrawRect& a, const DrawRect& b) { return a.z < b.z; };
+    // Стабільно, як у DrawListPainter: за рівного z — порядок додавання.
+    if (!std::is_sorted(m_rects.cbegin(), m_rects.cend(), byDepth))
+        std::stable_sort(m_rects.begin(), m_rects.end(), byDepth);
+
+    // Глибина шару — найменша серед його прямокутників; решта порядку всередині paint().
+    if (!m_rects.isEmpty() && zValue() != m_rects.first().z)
+        setZValue(m_rects.first().z);
+
+    QRectF bounds;
+    for (const DrawRect& rect : std::as_const(m_rects)) {
+        // Половина товщини обведення виходить за прямокутник.
+        const qreal margin = rect.pen.style() == Qt::NoPen ? 0.0 : qMax<qreal>(1.0, rect.pen.widthF());
+        bounds |= rect.rect.adjusted(-margin, -margin, margin, margin);
+    }
+
+    if (bounds != m_bounds) {
+        // Старі межі теж перемальовуються: там лишились минулі позиції.
+        prepareGeometryChange();
+        m_bounds = bounds;
+    }
+    if (!m_rects.isEmpty() || m_painted)
+        update();
+    m_painted = !m_rects.isEmpty();
+}
+
+void DrawBatchItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*)
+{
+    const QRectF exposed = option ? option->exposedRect : m_bounds;
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, false);
+    for (const DrawRect& rect : std::as_const(m_rects)) {
+        if (rect.rect.intersects(exposed))
+            DrawListPainter::paintRect(*painter, rect);
+    }
+    painter->restore();
+}
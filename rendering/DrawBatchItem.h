@@ -0,0 +1,42 @@
+#ifndef DRAWBATCHITEM_H
+#define DRAWBATCHITEM_H
+
+#include <QGraphicsItem>
+#include <QRectF>
+#include <QVector>
+
+#include "rendering/RenderBackend.h"
+
+class QPainter;
+class QStyleOptionGraphicsItem;
+class QWidget;
+
+/*
+ * DrawBatchItem — один елемент сцени на цілий шар DrawList (танки, стволи, кулі,
+ * вибухи). Замість QGraphicsRectItem на кожен об'єкт шар тримає плаский масив
+ * прямокутників і малює їх одним paint() тим самим кодом, що й растровий бекенд,
+ * тож ціна кадру залежить від пікселів, а не від кількості елементів у сцені.
+ * Прямокутники задаються в координатах сцени; сам елемент стоїть у (0, 0).
+ */
+class DrawBatchItem : public QGraphicsItem
+{
+public:
+    DrawBatchItem();
+
+    // Кадр збирається заново: clear(), append() для кожного прямокутника, commit().
+    void clear() { m_rects.clear(); }
+    void append(const DrawRect& rect) { m_rects.append(rect); }
+    // Упорядковує за z, бере найменшу z як глибину елемента, оновлює межі й планує перемальовування.
+    void commit();
+    bool isEmpty() const { return m_rects.isEmpty(); }
+
+    QRectF boundingRect() const override { return m_bounds; }
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*) override;
+
+private:
+    QVector<DrawRect> m_rects;
+    QRectF m_bounds;
+    bool m_painted = false;    // чи було щось видно минулого кадру
+};
+
+#endif // DRAWBATCHITEM_H
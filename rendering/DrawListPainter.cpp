@@ -0,0 +1,67 @@
+#include "rendering/DrawListPainter.h"
+
+#include <QPainter>
+#include <QRectF>
+#include <algorithm>
+
+void DrawListPainter::setDrawList(const DrawList& list)
+{
+    m_list = list;
+    sortByDepth();
+
+    const HudState& hud = m_list.hud;
+    if (hud.visible)
+        m_hud.setMetrics(hud.lives, hud.stars, hud.maxStars, hud.enemies, hud.score, hud.status, hud.tileSize);
+}
+
+void DrawListPainter::sortByDepth()
+{
+    const qsizetype count = m_list.rects.size();
+    m_order.resize(count);
+    for (qsizetype i = 0; i < count; ++i)
+        m_order[i] = static_cast<int>(i);
+    // Стабільне сортування: за рівного z порядок додавання, як у сцени з однаковою глибиною.
+    std::stable_sort(m_order.begin(), m_order.end(), [this](int a, int b) {
+        return m_list.rects.at(a).z < m_list.rects.at(b).z;
+    });
+}
+
+void DrawListPainter::paintRect(QPainter& painter, const DrawRect& rect)
+{
+    // Текстура пензля прив'язана до кута прямокутника, як у елемента сцени з pos = topLeft.
+    painter.setBrushOrigin(rect.rect.topLeft());
+    if (rect.pen.style() == Qt::NoPen) {
+        painter.fillRect(rect.rect, rect.brush);
+        return;
+    }
+    painter.setPen(rect.pen);
+    painter.setBrush(rect.brush);
+    painter.drawRect(rect.rect);
+}
+
+void DrawListPainter::paint(QPainter& painter, const QRectF& exposed)
+{
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setBrushOrigin(QPointF(0.0, 0.0));
+    painter.fillRect(exposed, RenderBackend::backgroundBrush());
+
+    if (m_list.hasMap) {
+        painter.setPen(m_list.framePen);
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(m_list.mapRect);
+    }
+
+    for (const int index : std::as_const(m_order)) {
+        const DrawRect& rect = m_list.rects.at(index);
+        if (rect.rect.intersects(exposed))
+            paintRect(painter, rect);
+    }
+
+    if (m_list.hud.visible) {
+        painter.setBrushOrigin(QPointF(0.0, 0.0));
+        painter.translate(m_list.hud.position);
+        m_hud.paint(&painter);
+    }
+    painter.restore();
+}
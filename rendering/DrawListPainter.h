@@ -0,0 +1,37 @@
+#ifndef DRAWLISTPAINTER_H
+#define DRAWLISTPAINTER_H
+
+#include <QVector>
+
+#include "rendering/HudPainter.h"
+#include "rendering/RenderBackend.h"
+
+class QPainter;
+class QRectF;
+
+/*
+ * DrawListPainter малює DrawList одним проходом QPainter: фон, рамка поля,
+ * прямокутники за зростанням z і HUD. Спільний для вікна та кадрів без вікна,
+ * тож обидва шляхи дають однакові пікселі. Порядок за z збігається зі сценою.
+ */
+class DrawListPainter
+{
+public:
+    // Запам'ятовує кадр і впорядковує його прямокутники; дешевше за копію, бо списки неявно спільні.
+    void setDrawList(const DrawList& list);
+    const DrawList& drawList() const { return m_list; }
+
+    // exposed — область, яку треба оновити (у пікселях кадру); прямокутники поза нею пропускаються.
+    void paint(QPainter& painter, const QRectF& exposed);
+    // Один прямокутник; спільний із пакетними елементами сцени (DrawBatchItem).
+    static void paintRect(QPainter& painter, const DrawRect& rect);
+
+private:
+    void sortByDepth();
+
+    DrawList m_list;
+    QVector<int> m_order;       // індекси m_list.rects за зростанням z, перевикористовується між кадрами
+    HudPainter m_hud;
+};
+
+#endif // DRAWLISTPAINTER_H
@@ -0,0 +1,110 @@
+#include "rendering/FrameExporter.h"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+FrameExporter::~FrameExporter()
+{
+    finish();
+}
+
+bool FrameExporter::open(const Options& options)
+{
+    finish();
+    m_options = options;
+    m_framesWritten = 0;
+    m_bytesWritten = 0;
+    m_error.clear();
+    if (!m_options.pool)
+        m_options.pool = QThreadPool::globalInstance();
+    m_maxInFlight = m_options.maxInFlight > 0 ? m_options.maxInFlight : 2 * qMax(1, m_options.pool->maxThreadCount());
+
+    if (m_options.format != FrameWriter::Format::Y4m) {
+        m_directory = QDir(m_options.outputPath);
+        if (!QDir().mkpath(m_directory.absolutePath()))
+            return fail(QStringLiteral("cannot create %1").arg(m_directory.absolutePath()));
+        m_open = true;
+        return true;
+    }
+
+    if (m_options.frameSize.isEmpty())
+        return fail(QStringLiteral("Y4M stream needs a frame size"));
+    m_stream.setFileName(m_options.outputPath);
+    if (!m_stream.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return fail(m_stream.errorString());
+    const QByteArray header = FrameWriter::y4mHeader(m_options.frameSize, m_options.fpsNumerator, m_options.fpsDenominator);
+    if (m_stream.write(header) != header.size())
+        return fail(m_stream.errorString());
+    m_bytesWritten += header.size();
+    m_open = true;
+    return true;
+}
+
+bool FrameExporter::addFrame(const QImage& image, qint64 frame)
+{
+    if (!m_open || !m_error.isEmpty())
+        return false;
+    if (m_options.format == FrameWriter::Format::Y4m && image.size() != m_options.frameSize)
+        return fail(QStringLiteral("frame %1 does not match the stream size").arg(frame));
+
+    // Спершу звільняємо місце, щоби в польоті ніколи не було більше maxInFlight кадрів.
+    while (m_pending.size() >= m_maxInFlight) {
+        if (!writeOldest())
+            return false;
+    }
+
+    // Копія QImage лише збільшує лічильник посилань; наступне малювання
+    // в оригінал відокремить його буфер, тож задача бачить незмінний кадр.
+    const FrameWriter::Format format = m_options.format;
+    PendingFrame pending;
+    pending.frame = frame;
+    pending.data = QtConcurrent::run(m_options.pool, [image, format]() { return FrameWriter::encode(image, format); });
+    m_pending.enqueue(pending);
+    return true;
+}
+
+bool FrameExporter::finish()
+{
+    bool ok = m_error.isEmpty();
+    while (!m_pending.isEmpty()) {
+        if (ok) {
+            ok = writeOldest();
+        } else {
+            // Після помилки решту кадрів лише дочікуємось, щоби задачі не пережили буфери.
+            m_pending.head().data.waitForFinished();
+            m_pending.dequeue();
+        }
+    }
+    if (m_stream.isOpen())
+        m_stream.close();
+    m_open = false;
+    return ok;
+}
+
+bool FrameExporter::writeOldest()
+{
+    PendingFrame pending = m_pending.dequeue();
+    pending.data.waitForFinished();
+    const QByteArray bytes = pending.data.result();
+    if (bytes.isEmpty())
+        return fail(QStringLiteral("frame %1: encoding failed").arg(pending.frame));
+
+    if (m_options.format == FrameWriter::Format::Y4m) {
+        if (m_stream.write(bytes) != bytes.size())
+            return fail(m_stream.errorString());
+    } else {
+        QFile file(m_directory.filePath(FrameWriter::fileName(pending.frame, m_options.format)));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(bytes) != bytes.size())
+            return fail(QStringLiteral("%1: %2").arg(file.fileName(), file.errorString()));
+    }
+    ++m_framesWritten;
+    m_bytesWritten += bytes.size();
+    return true;
+}
+
+bool FrameExporter::fail(const QString& message)
+{
+    if (m_error.isEmpty())
+        m_error = message;
+    return false;
+}
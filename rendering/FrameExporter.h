@@ -0,0 +1,79 @@
+#ifndef FRAMEEXPORTER_H
+#define FRAMEEXPORTER_H
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QFuture>
+#include <QImage>
+#include <QQueue>
+#include <QSize>
+#include <QString>
+#include <QtGlobal>
+
+#include "rendering/FrameWriter.h"
+
+class QThreadPool;
+
+/*
+ * FrameExporter кодує кадри паралельно й записує їх строго в порядку подачі.
+ * Малює один потік (Renderer і OffscreenRenderer не потокобезпечні), а кожен
+ * поданий кадр — неявно спільна копія QImage — кодується окремою задачею
+ * QtConcurrent на пулі потоків. У польоті не більше maxInFlight кадрів: коли черга
+ * повна, addFrame чекає найстаріший кадр і записує його, тож пам'ять обмежена
+ * чергою, а порядок запису збігається з порядком кадрів.
+ * PNG і raw — файл на кадр у каталозі (FrameWriter::fileName), Y4M — один файл-потік.
+ */
+class FrameExporter
+{
+public:
+    struct Options
+    {
+        FrameWriter::Format format = FrameWriter::Format::Png;
+        QString outputPath;         // каталог для PNG і raw, файл для Y4M
+        QSize frameSize;            // розмір усіх кадрів потоку Y4M
+        int fpsNumerator = 60;
+        int fpsDenominator = 1;
+        int maxInFlight = 0;        // 0 — удвічі більше, ніж потоків у пулі
+        QThreadPool* pool = nullptr;    // nullptr — QThreadPool::globalInstance()
+    };
+
+    FrameExporter() = default;
+    // Дописує кадри, що ще кодуються.
+    ~FrameExporter();
+    FrameExporter(const FrameExporter&) = delete;
+    FrameExporter& operator=(const FrameExporter&) = delete;
+
+    bool open(const Options& options);
+    // frame — номер для імені файлу; false — попередній запис не вдався (див. errorString()).
+    bool addFrame(const QImage& image, qint64 frame);
+    // Чекає всі кадри в польоті й закриває потік.
+    bool finish();
+
+    QString errorString() const { return m_error; }
+    qint64 framesWritten() const { return m_framesWritten; }
+    qint64 bytesWritten() const { return m_bytesWritten; }
+    int maxInFlight() const { return m_maxInFlight; }
+
+private:
+    struct PendingFrame
+    {
+        qint64 frame = 0;
+        QFuture<QByteArray> data;
+    };
+
+    bool writeOldest();
+    bool fail(const QString& message);
+
+    Options m_options;
+    QDir m_directory;
+    QFile m_stream;
+    QQueue<PendingFrame> m_pending;
+    int m_maxInFlight = 1;
+    qint64 m_framesWritten = 0;
+    qint64 m_bytesWritten = 0;
+    QString m_error;
+    bool m_open = false;
+};
+
+#endif // FRAMEEXPORTER_H
@@ -0,0 +1,146 @@
+#include "rendering/FrameWriter.h"
+
+#include <QBuffer>
+#include <QColor>
+#include <QFile>
+#include <QtGlobal>
+#include <cstring>
+
+namespace {
+constexpr int kFrameNumberDigits = 6;
+
+QImage toRgb32(const QImage& image)
+{
+    return image.format() == QImage::Format_RGB32 ? image : image.convertToFormat(QImage::Format_RGB32);
+}
+
+QByteArray encodeRaw(const QImage& image)
+{
+    const QImage frame = toRgb32(image);
+    const qsizetype rowBytes = static_cast<qsizetype>(frame.width()) * 4;
+    QByteArray bytes;
+    bytes.reserve(rowBytes * frame.height());
+    for (int y = 0; y < frame.height(); ++y)
+        bytes.append(reinterpret_cast<const char*>(frame.constScanLine(y)), rowBytes);
+    return bytes;
+}
+
+// Цілочисельний BT.601 повного діапазону (як у JPEG, що й означає C420jpeg у заголовку).
+quint8 lumaOf(int r, int g, int b)
+{
+    return static_cast<quint8>((77 * r + 150 * g + 29 * b + 128) >> 8);
+}
+
+quint8 clampByte(int value)
+{
+    return static_cast<quint8>(qBound(0, value, 255));
+}
+
+QByteArray encodeY4mFrame(const QImage& image)
+{
+    const QImage frame = toRgb32(image);
+    const int width = frame.width();
+    const int height = frame.height();
+    // Площини кольору вдвічі менші з округленням угору, як вимагає 4:2:0 для непарних розмірів.
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+
+    static const QByteArray kFrameTag("FRAME\n");
+    const qsizetype lumaSize = static_cast<qsizetype>(width) * height;
+    const qsizetype chromaSize = static_cast<qsizetype>(chromaWidth) * chromaHeight;
+    QByteArray bytes(kFrameTag.size() + lumaSize + 2 * chromaSize, Qt::Uninitialized);
+    memcpy(bytes.data(), kFrameTag.constData(), kFrameTag.size());
+    quint8* luma = reinterpret_cast<quint8*>(bytes.data()) + kFrameTag.size();
+    quint8* cb = luma + lumaSize;
+    quint8* cr = cb + chromaSize;
+
+    for (int y = 0; y < height; ++y) {
+        const QRgb* row = reinterpret_cast<const QRgb*>(frame.constScanLine(y));
+        quint8* out = luma + static_cast<qsizetype>(y) * width;
+        for (int x = 0; x < width; ++x)
+            out[x] = lumaOf(qRed(row[x]), qGreen(row[x]), qBlue(row[x]));
+    }
+
+    // Кожен відлік кольору — середнє блоку 2×2 (центроване положення, як у C420jpeg).
+    for (int cy = 0; cy < chromaHeight; ++cy) {
+        const QRgb* top = reinterpret_cast<const QRgb*>(frame.constScanLine(2 * cy));
+        const QRgb* bottom = reinterpret_cast<const QRgb*>(frame.constScanLine(qMin(2 * cy + 1, height - 1)));
+        for (int cx = 0; cx < chromaWidth; ++cx) {
+            const int x0 = 2 * cx;
+            const int x1 = qMin(x0 + 1, width - 1);
+            const int r = qRed(top[x0]) + qRed(top[x1]) + qRed(bottom[x0]) + qRed(bottom[x1]);
+            const int g = qGreen(top[x0]) + qGreen(top[x1]) + qGreen(bottom[x0]) + qGreen(bottom[x1]);
+            const int b = qBlue(top[x0]) + qBlue(top[x1]) + qBlue(bottom[x0]) + qBlue(bottom[x1]);
+            // Суми чотирьох пікселів: зсув на 10 замість 8 ділить ще й на 4.
+            const qsizetype index = static_cast<qsizetype>(cy) * chromaWidth + cx;
+            cb[index] = clampByte(((-43 * r - 85 * g + 128 * b + 512) >> 10) + 128);
+            cr[index] = clampByte(((128 * r - 107 * g - 21 * b + 512) >> 10) + 128);
+        }
+    }
+    return bytes;
+}
+} // namespace
+
+QString FrameWriter::fileSuffix(Format format)
+{
+    switch (format) {
+    case Format::Png: return QStringLiteral("png");
+    case Format::Raw: return QStringLiteral("raw");
+    case Format::Y4m: return QStringLiteral("y4m");
+    }
+    return QString();
+}
+
+QString FrameWriter::fileName(qint64 frame, Format format)
+{
+    return QStringLiteral("frame_%1.%2").arg(frame, kFrameNumberDigits, 10, QLatin1Char('0')).arg(fileSuffix(format));
+}
+
+QByteArray FrameWriter::encode(const QImage& image, Format format)
+{
+    switch (format) {
+    case Format::Png: {
+        QByteArray bytes;
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::WriteOnly);
+        if (!image.save(&buffer, "PNG"))
+            return QByteArray();
+        return bytes;
+    }
+    case Format::Raw:
+        return encodeRaw(image);
+    case Format::Y4m:
+        return encodeY4mFrame(image);
+    }
+    return QByteArray();
+}
+
+QByteArray FrameWriter::y4mHeader(const QSize& size, int fpsNumerator, int fpsDenominator)
+{
+    return QStringLiteral("YUV4MPEG2 W%1 H%2 F%3:%4 Ip A1:1 C420jpeg\n")
+        .arg(size.width())
+        .arg(size.height())
+        .arg(fpsNumerator)
+        .arg(fpsDenominator)
+        .toLatin1();
+}
+
+bool FrameWriter::write(const QImage& image, const QString& filePath, Format format, QString* error)
+{
+    QByteArray bytes = encode(image, format);
+    if (bytes.isEmpty()) {
+        if (error)
+            *error = QStringLiteral("%1 encoding failed").arg(fileSuffix(format).toUpper());
+        return false;
+    }
+    if (format == Format::Y4m)
+        bytes.prepend(y4mHeader(image.size(), 1, 1));
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(bytes) != bytes.size()) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef FRAMEWRITER_H
+#define FRAMEWRITER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+/*
+ * FrameWriter зберігає кадри без вікна: PNG для перегляду чи мініатюр і «сирі»
+ * кадри — пікселі QImage::Format_RGB32 рядок за рядком без заголовка
+ * (0xffRRGGBB у порядку байтів машини), які зручно хешувати чи віддати іншим інструментам.
+ * Y4M — нестиснений відеопотік YUV 4:2:0 (BT.601, повний діапазон), який без
+ * перетворень читають ffmpeg і mpv: заголовок потоку, далі FRAME і три площини на кадр.
+ * Функції без стану, тож кадри можна кодувати з кількох потоків.
+ */
+namespace FrameWriter {
+enum class Format {
+    Png,
+    Raw,
+    Y4m
+};
+
+QString fileSuffix(Format format);
+// frame_000042.png — номер кадру з нулями попереду, щоби послідовність сортувалась як текст.
+QString fileName(qint64 frame, Format format);
+// Байти одного кадру; для Y4M — запис FRAME без заголовка потоку.
+QByteArray encode(const QImage& image, Format format);
+// Заголовок потоку Y4M: розмір і частота кадрів дробом fpsNumerator/fpsDenominator.
+QByteArray y4mHeader(const QSize& size, int fpsNumerator, int fpsDenominator);
+// Окремий файл кадру; Y4M пишеться як потік з одного кадру.
+bool write(const QImage& image, const QString& filePath, Format format, QString* error = nullptr);
+}
+
+#endif // FRAMEWRITER_H
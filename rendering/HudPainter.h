@@ -0,0 +1,68 @@
+#ifndef HUDPAINTER_H
+#define HUDPAINTER_H
+
+#include <QFont>
+#include <QPixmap>
+#include <QPointF>
+#include <QRectF>
+#include <QStaticText>
+#include <QString>
+
+class QPainter;
+
+/*
+ * HudPainter — малювання панелі показників лише засобами QtGui. Уміст малюється
+ * один раз у кешований QPixmap (з розкладками тексту QStaticText) і перебудовується
+ * лише коли змінюються показники чи розмір тайла; решту кадрів paint() — одне копіювання.
+ * Спільний для HudItem на сцені та DrawListPainter, тож framedump обходиться без QtWidgets.
+ */
+class HudPainter
+{
+public:
+    // true, якщо вигляд панелі змінився і її треба перемалювати.
+    bool setMetrics(int lives, int stars, int maxStars, int enemies, int score, const QString& status, qreal tileSize);
+
+    const QRectF& bounds() const { return m_bounds; }
+    // Малює панель з верхнім лівим кутом у початку координат painter.
+    void paint(QPainter* painter);
+
+private:
+    void updateFont(qreal tileSize);
+    void updateTexts();
+    void updateBounds();
+    void rebuildCache(qreal devicePixelRatio);
+    void paintContent(QPainter* painter);
+    void drawTankIcon(QPainter* painter, const QPointF& topLeft, qreal size) const;
+    void drawStarIcon(QPainter* painter, const QPointF& center, qreal outerRadius, bool filled) const;
+    void drawEnemyIcon(QPainter* painter, const QPointF& topLeft, qreal size) const;
+
+    int m_lives = 0;
+    int m_stars = 0;
+    int m_maxStars = 0;
+    int m_enemies = 0;
+    int m_score = 0;
+    QString m_statusText;
+
+    qreal m_tileSize = 0.0;
+    qreal m_labelWidth = 0.0;
+    qreal m_lineHeight = 0.0;
+    qreal m_iconSize = 0.0;
+    QRectF m_bounds{0.0, 0.0, 1.0, 1.0};
+    QFont m_font;
+
+    // Розкладки тексту: підписи — зі шрифтом, значення — з показниками.
+    QStaticText m_livesLabel;
+    QStaticText m_starsLabel;
+    QStaticText m_enemiesLabel;
+    QStaticText m_scoreLabel;
+    QStaticText m_livesValue;
+    QStaticText m_enemiesValue;
+    QStaticText m_scoreValue;
+    QStaticText m_statusValue;
+
+    QPixmap m_cache;
+    qreal m_cacheRatio = 0.0;
+    bool m_cacheValid = false;
+};
+
+#endif // HUDPAINTER_H
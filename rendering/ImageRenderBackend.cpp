@@ -0,0 +1,20 @@
+#include "rendering/ImageRenderBackend.h"
+
+#include <QPainter>
+#include <QRectF>
+
+ImageRenderBackend::ImageRenderBackend(const QSize& size)
+    : m_image(size, QImage::Format_RGB32)
+{
+    m_image.fill(Qt::black);
+}
+
+void ImageRenderBackend::submit(const DrawList& list)
+{
+    if (!m_paintEnabled || m_image.isNull())
+        return;
+
+    m_painter.setDrawList(list);
+    QPainter painter(&m_image);
+    m_painter.paint(painter, QRectF(m_image.rect()));
+}
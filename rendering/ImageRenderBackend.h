@@ -0,0 +1,33 @@
+#ifndef IMAGERENDERBACKEND_H
+#define IMAGERENDERBACKEND_H
+
+#include <QImage>
+#include <QSize>
+
+#include "rendering/DrawListPainter.h"
+#include "rendering/RenderBackend.h"
+
+/*
+ * ImageRenderBackend малює кожен поданий кадр у власний QImage фіксованого
+ * розміру: без вікна, QGraphicsView і сцени, тож працює в процесі лише з QtGui
+ * на платформі offscreen. Пікселі ті самі, що й у растрового бекенду вікна.
+ */
+class ImageRenderBackend : public RenderBackend
+{
+public:
+    explicit ImageRenderBackend(const QSize& size);
+
+    QSize viewportSize() const override { return m_image.size(); }
+    void submit(const DrawList& list) override;
+
+    // false — submit нічого не малює; для проміжних тиків, коли потрібен лише кожен N-й кадр.
+    void setPaintEnabled(bool enabled) { m_paintEnabled = enabled; }
+    const QImage& image() const { return m_image; }
+
+private:
+    QImage m_image;
+    DrawListPainter m_painter;
+    bool m_paintEnabled = true;
+};
+
+#endif // IMAGERENDERBACKEND_H
@@ -0,0 +1,36 @@
+#include "rendering/OffscreenRenderer.h"
+
+#include <utility>
+
+#include "rendering/ImageRenderBackend.h"
+#include "rendering/Renderer.h"
+
+namespace {
+// Між тиками симуляції немає проміжних станів, тож кадр показує кінцеві позиції тику.
+constexpr qreal kTickAlpha = 1.0;
+} // namespace
+
+OffscreenRenderer::OffscreenRenderer(const QSize& size)
+{
+    auto backend = std::make_unique<ImageRenderBackend>(size);
+    m_backend = backend.get();
+    m_renderer = std::make_unique<Renderer>(std::move(backend));
+}
+
+OffscreenRenderer::~OffscreenRenderer() = default;
+
+void OffscreenRenderer::setSpriteManager(SpriteManager* manager)
+{
+    m_renderer->setSpriteManager(manager);
+}
+
+void OffscreenRenderer::renderFrame(const Game& game, bool paint)
+{
+    m_backend->setPaintEnabled(paint);
+    m_renderer->renderFrame(game, kTickAlpha);
+}
+
+const QImage& OffscreenRenderer::image() const
+{
+    return m_backend->image();
+}
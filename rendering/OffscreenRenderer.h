@@ -0,0 +1,35 @@
+#ifndef OFFSCREENRENDERER_H
+#define OFFSCREENRENDERER_H
+
+#include <QImage>
+#include <QSize>
+#include <memory>
+
+class Game;
+class ImageRenderBackend;
+class Renderer;
+class SpriteManager;
+
+/*
+ * OffscreenRenderer — Renderer із бекендом у QImage для кадрів без дисплея:
+ * знімки, хеші кадрів у тестах, мініатюри. Renderer веде вибухи й кулі між
+ * кадрами, тож сюди треба передавати кожен тік; paint = false лише оновлює цей
+ * стан, не витрачаючи час на пікселі.
+ */
+class OffscreenRenderer
+{
+public:
+    explicit OffscreenRenderer(const QSize& size);
+    ~OffscreenRenderer();
+
+    // Для відтворюваних кадрів атлас має бути вже завантажений (SpriteManager::waitForLoaded).
+    void setSpriteManager(SpriteManager* manager);
+    void renderFrame(const Game& game, bool paint = true);
+    const QImage& image() const;
+
+private:
+    ImageRenderBackend* m_backend = nullptr;    // належить m_renderer
+    std::unique_ptr<Renderer> m_renderer;
+};
+
+#endif // OFFSCREENRENDERER_H
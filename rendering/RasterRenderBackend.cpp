@@ -0,0 +1,83 @@
+#include "rendering/RasterRenderBackend.h"
+
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QRectF>
+#include <QWidget>
+
+RasterGameView::RasterGameView(QGraphicsScene* scene, QWidget* parent)
+    : QGraphicsView(scene, parent)
+{
+    // Кадр змінюється цілком, тож часткові оновлення лише додають облік областей.
+    setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+    setCacheMode(QGraphicsView::CacheNone);
+    setOptimizationFlag(QGraphicsView::DontSavePainterState, true);
+}
+
+void RasterGameView::drawBackground(QPainter* painter, const QRectF& rect)
+{
+    if (!m_backend) {
+        QGraphicsView::drawBackground(painter, rect);
+        return;
+    }
+    m_backend->paint(*painter, rect);
+}
+
+RasterRenderBackend::RasterRenderBackend(RasterGameView* view)
+    : m_view(view)
+{
+    if (m_view)
+        m_view->setBackend(this);
+}
+
+RasterRenderBackend::~RasterRenderBackend()
+{
+    if (m_view)
+        m_view->setBackend(nullptr);
+}
+
+QSize RasterRenderBackend::viewportSize() const
+{
+    if (!m_view || !m_view->viewport())
+        return QSize();
+    return m_view->viewport()->size();
+}
+
+void RasterRenderBackend::submit(const DrawList& list)
+{
+    m_painter.setDrawList(list);
+    m_pixelScale = qMax(1, list.pixelScale);
+    if (m_pixelScale > 1 && !list.viewportSize.isEmpty()) {
+        if (m_frame.size() != list.viewportSize)
+            m_frame = QImage(list.viewportSize, QImage::Format_RGB32);
+        QPainter painter(&m_frame);
+        m_painter.paint(painter, QRectF(m_frame.rect()));
+    } else {
+        m_frame = QImage();
+    }
+    if (!m_view)
+        return;
+
+    // Сцена з меню має збігатися з вікном, як і у сценовому бекенді; змінюється лише з геометрією.
+    if (list.layoutVersion != m_layoutVersion) {
+        m_layoutVersion = list.layoutVersion;
+        if (QGraphicsScene* scene = m_view->scene(); scene && !list.viewportSize.isEmpty())
+            scene->setSceneRect(QRectF(QPointF(0.0, 0.0), QSizeF(list.viewportSize * m_pixelScale)));
+    }
+    if (m_view->viewport())
+        m_view->viewport()->update();
+}
+
+void RasterRenderBackend::paint(QPainter& painter, const QRectF& exposed)
+{
+    if (m_frame.isNull()) {
+        m_painter.paint(painter, exposed);
+        return;
+    }
+
+    // Цілий множник без згладжування: кожен піксель кадру стає рівним квадратом.
+    painter.save();
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(QRectF(QPointF(0.0, 0.0), QSizeF(m_frame.size() * m_pixelScale)), m_frame);
+    painter.restore();
+}
@@ -0,0 +1,60 @@
+#ifndef RASTERRENDERBACKEND_H
+#define RASTERRENDERBACKEND_H
+
+#include <QGraphicsView>
+#include <QImage>
+
+#include "rendering/DrawListPainter.h"
+#include "rendering/RenderBackend.h"
+
+class QPainter;
+class QRectF;
+class RasterRenderBackend;
+
+/*
+ * RasterGameView — вид, у якого ігрове поле малюється прямо у фоні кадру.
+ * Сцена лишається лише для меню та оверлею редактора, тож танки, кулі й тайли
+ * не мають елементів, індексу BSP і обліку створення/видалення.
+ */
+class RasterGameView : public QGraphicsView
+{
+public:
+    explicit RasterGameView(QGraphicsScene* scene, QWidget* parent = nullptr);
+
+    void setBackend(RasterRenderBackend* backend) { m_backend = backend; }
+
+protected:
+    void drawBackground(QPainter* painter, const QRectF& rect) override;
+
+private:
+    RasterRenderBackend* m_backend = nullptr;
+};
+
+/*
+ * RasterRenderBackend зберігає останній DrawList і малює його у фоні
+ * RasterGameView через DrawListPainter, без жодного елемента сцени.
+ * Якщо кадр має pixelScale > 1, він малюється один раз у QImage своєї низької
+ * роздільності, а у вікно лише збільшується найближчим сусідом: ціна заливки не
+ * залежить від монітора, а піксель-арт лишається чітким на HiDPI.
+ */
+class RasterRenderBackend : public RenderBackend
+{
+public:
+    explicit RasterRenderBackend(RasterGameView* view);
+    ~RasterRenderBackend() override;
+
+    QSize viewportSize() const override;
+    void submit(const DrawList& list) override;
+
+    // Малює останній поданий кадр; exposed — область, яку треба оновити (у пікселях кадру).
+    void paint(QPainter& painter, const QRectF& exposed);
+
+private:
+    RasterGameView* m_view = nullptr;
+    DrawListPainter m_painter;
+    QImage m_frame;             // кадр низької роздільності, коли m_pixelScale > 1
+    int m_pixelScale = 1;
+    quint64 m_layoutVersion = 0;
+};
+
+#endif // RASTERRENDERBACKEND_H
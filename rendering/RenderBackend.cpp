@@ -0,0 +1,22 @@
+#include "rendering/RenderBackend.h"
+
+#include <QColor>
+#include <QPainter>
+#include <QPixmap>
+
+QBrush RenderBackend::backgroundBrush()
+{
+    static const QBrush brush = []() {
+        QPixmap pattern(24, 24);
+        pattern.fill(QColor(12, 12, 16));
+        QPainter painter(&pattern);
+        painter.setRenderHint(QPainter::Antialiasing, false);
+        painter.setPen(QColor(22, 22, 28));
+        painter.drawRect(pattern.rect().adjusted(0, 0, -1, -1));
+        painter.drawLine(0, pattern.height() / 2, pattern.width(), pattern.height() / 2);
+        painter.drawLine(pattern.width() / 2, 0, pattern.width() / 2, pattern.height());
+        painter.end();
+        return QBrush(pattern);
+    }();
+    return brush;
+}
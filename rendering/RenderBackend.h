@@ -0,0 +1,103 @@
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include <QBrush>
+#include <QPen>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+class QPainter;
+
+enum class RenderBackendKind {
+    Scene,      // QGraphicsScene з утримуваними елементами
+    Raster      // один прохід QPainter без графа сцени
+};
+
+struct RenderSettings
+{
+    RenderBackendKind backend = RenderBackendKind::Scene;
+    // >0 — поле малюється з тайлом приблизно стільки пікселів і збільшується
+    // у вікно цілим множником (лише растровий бекенд); 0 — у повній роздільності вікна.
+    int pixelTileSize = 0;
+};
+
+// Шари кадру; утримувальний бекенд розрізняє елементи за парою (шар, ключ).
+enum class DrawLayer : quint8 {
+    Tiles,
+    Bonuses,
+    Tanks,
+    Barrels,
+    Bullets,
+    Explosions
+};
+inline constexpr int kDrawLayerCount = static_cast<int>(DrawLayer::Explosions) + 1;
+
+struct DrawRect
+{
+    QRectF rect;                // у координатах сцени (= пікселі вікна)
+    QBrush brush;
+    QPen pen = QPen(Qt::NoPen);
+    qreal z = 0.0;
+    DrawLayer layer = DrawLayer::Tiles;
+    quintptr key = 0;           // стабільний між кадрами: клітинка, об'єкт або порядковий номер
+};
+
+struct HudState
+{
+    bool visible = false;
+    QPointF position;
+    int lives = 0;
+    int stars = 0;
+    int maxStars = 0;
+    int enemies = 0;
+    int score = 0;
+    QString status;
+    qreal tileSize = 0.0;
+};
+
+/*
+ * DrawList — усе, що треба намалювати за кадр: прямокутники з пензлями й глибиною,
+ * рамка поля та показники HUD. Renderer заповнює його зі стану Game, а бекенд
+ * вирішує, як це показати. Список перевикористовується між кадрами без перевиділень.
+ */
+struct DrawList
+{
+    QSize viewportSize;         // розмір кадру; вікно більше в pixelScale разів
+    int pixelScale = 1;
+    quint64 layoutVersion = 0;  // росте зі зміною геометрії (RenderLayout, рух камери): бекенд оновлює сцену лише тоді
+    bool hasMap = false;
+    QRectF mapRect;
+    QPen framePen;
+    QVector<DrawRect> rects;
+    HudState hud;
+
+    void clear()
+    {
+        hasMap = false;
+        rects.clear();
+        hud.visible = false;
+    }
+};
+
+/*
+ * RenderBackend — спосіб показати DrawList. Сценовий бекенд тримає QGraphicsRectItem
+ * на кожен прямокутник, растровий малює весь кадр одним QPainter.
+ */
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    // Розмір області, куди малюється кадр; порожній — малювати поки нікуди.
+    virtual QSize viewportSize() const = 0;
+    virtual void submit(const DrawList& list) = 0;
+
+    // Спільний для бекендів фон поза полем: темна сітка 24×24.
+    static QBrush backgroundBrush();
+};
+
+#endif // RENDERBACKEND_H
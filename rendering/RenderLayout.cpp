@@ -0,0 +1,93 @@
+#include "rendering/RenderLayout.h"
+
+#include <QColor>
+#include <algorithm>
+
+#include "utils/Constants.h"
+
+namespace {
+// Межі тайла палітри редактора й розмір, поки карти ще немає.
+constexpr qreal kEditorMinTile = 18.0;
+constexpr qreal kEditorMaxTile = 56.0;
+constexpr qreal kEditorDefaultTile = 26.0;
+} // namespace
+
+RenderLayout::RenderLayout()
+    : m_tileSize(TILE_SIZE)
+    , m_editorTileSize(kEditorDefaultTile)
+{
+}
+
+bool RenderLayout::setViewportSize(const QSize& size)
+{
+    if (size == m_viewportSize)
+        return false;
+    m_viewportSize = size;
+    recompute();
+    return true;
+}
+
+bool RenderLayout::setPixelTileSize(int pixels)
+{
+    pixels = qMax(0, pixels);
+    if (pixels == m_pixelTileSize)
+        return false;
+    m_pixelTileSize = pixels;
+    recompute();
+    return true;
+}
+
+bool RenderLayout::setMapSize(const QSize& size)
+{
+    if (size == m_mapSize)
+        return false;
+    m_mapSize = size;
+    recompute();
+    return true;
+}
+
+QPointF RenderLayout::hudPositionFor(const QRectF& mapRect, const QSize& viewport, qreal tileSize)
+{
+    const qreal hudMargin = tileSize * 0.5;
+    const qreal hudX = std::min(mapRect.right() + hudMargin, static_cast<qreal>(viewport.width()) - hudMargin);
+    return QPointF(hudX, std::max(mapRect.top(), 0.0) + hudMargin);
+}
+
+void RenderLayout::recompute()
+{
+    ++m_version;
+    m_frameSize = m_viewportSize;
+    m_pixelScale = 1;
+    // Без вікна чи карти лишається попередня геометрія, як і раніше в Renderer.
+    if (m_viewportSize.isEmpty() || m_mapSize.isEmpty())
+        return;
+
+    const qreal mapWidthTiles = static_cast<qreal>(m_mapSize.width());
+    const qreal mapHeightTiles = static_cast<qreal>(m_mapSize.height());
+    if (m_pixelTileSize > 0) {
+        const qreal fitTile = std::min(m_viewportSize.width() / mapWidthTiles, m_viewportSize.height() / mapHeightTiles);
+        m_pixelScale = qMax(1, static_cast<int>(fitTile / m_pixelTileSize));
+        // Кадр із запасом до цілого: після збільшення він покриває все вікно.
+        m_frameSize = QSize((m_viewportSize.width() + m_pixelScale - 1) / m_pixelScale,
+                            (m_viewportSize.height() + m_pixelScale - 1) / m_pixelScale);
+    }
+
+    const qreal viewportWidth = static_cast<qreal>(m_frameSize.width());
+    const qreal viewportHeight = static_cast<qreal>(m_frameSize.height());
+
+    const qreal scale = std::min(viewportWidth / mapWidthTiles, viewportHeight / mapHeightTiles);
+    if (scale <= 0.0)
+        return;
+
+    m_valid = true;
+    m_tileSize = scale;
+    const QSizeF mapPixels(mapWidthTiles * scale, mapHeightTiles * scale);
+    m_mapOffset = QPointF((viewportWidth - mapPixels.width()) / 2.0, (viewportHeight - mapPixels.height()) / 2.0);
+    m_mapRect = QRectF(m_mapOffset, mapPixels);
+    m_framePen = QPen(QColor(70, 70, 80), std::max(1.0, scale * 0.06));
+
+    m_hudPosition = hudPositionFor(m_mapRect, m_frameSize, scale);
+
+    // Палітра редактора лежить на сцені вікна, тож її тайл — у пікселях вікна.
+    m_editorTileSize = qBound(kEditorMinTile, scale * m_pixelScale, kEditorMaxTile);
+}
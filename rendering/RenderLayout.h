@@ -0,0 +1,69 @@
+#ifndef RENDERLAYOUT_H
+#define RENDERLAYOUT_H
+
+#include <QPen>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <QtGlobal>
+
+/*
+ * RenderLayout — уся похідна від розміру вікна й карти геометрія кадру:
+ * розмір тайла, зсув і рамка поля, позиція HUD, розмір тайла редактора.
+ * Перераховується лише коли змінюється вхід (MainWindow::resizeEvent або
+ * новий рівень іншого розміру) і щоразу збільшує version(). Renderer, бекенди
+ * й оверлей редактора звіряють версію з запам'ятованою замість того, щоби
+ * рахувати геометрію щокадру.
+ * З setPixelTileSize() поле малюється у кадр низької роздільності (frameSize)
+ * з тайлом не менше заданого й збільшується у вікно в pixelScale() разів найближчим
+ * сусідом; уся геометрія, крім editorTileSize, — у пікселях цього кадру.
+ */
+class RenderLayout
+{
+public:
+    RenderLayout();
+
+    // true — вхід змінився й геометрію перераховано.
+    bool setViewportSize(const QSize& size);
+    bool setMapSize(const QSize& size);
+    // 0 — кадр збігається з вікном; інакше найбільший цілий множник, за якого тайл не менший за pixels.
+    bool setPixelTileSize(int pixels);
+
+    quint64 version() const { return m_version; }
+    // false — ще немає ні вікна, ні карти; тоді діє розмір тайла за замовчуванням.
+    bool isValid() const { return m_valid; }
+
+    QSize viewportSize() const { return m_viewportSize; }
+    QSize frameSize() const { return m_frameSize; }
+    int pixelScale() const { return m_pixelScale; }
+    QSize mapSize() const { return m_mapSize; }
+    qreal tileSize() const { return m_tileSize; }
+    QPointF mapOffset() const { return m_mapOffset; }
+    QRectF mapRect() const { return m_mapRect; }
+    const QPen& framePen() const { return m_framePen; }
+    QPointF hudPosition() const { return m_hudPosition; }
+    qreal editorTileSize() const { return m_editorTileSize; }
+
+    // HUD праворуч від поля, але не за краєм вікна; спільне з камерою, що зсуває поле.
+    static QPointF hudPositionFor(const QRectF& mapRect, const QSize& viewport, qreal tileSize);
+
+private:
+    void recompute();
+
+    QSize m_viewportSize;
+    QSize m_mapSize;
+    int m_pixelTileSize = 0;
+    QSize m_frameSize;
+    int m_pixelScale = 1;
+    quint64 m_version = 0;
+    bool m_valid = false;
+
+    qreal m_tileSize = 0.0;
+    QPointF m_mapOffset{0.0, 0.0};
+    QRectF m_mapRect;
+    QPen m_framePen;
+    QPointF m_hudPosition;
+    qreal m_editorTileSize = 0.0;
+};
+
+#endif // RENDERLAYOUT_H
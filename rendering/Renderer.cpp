@@ -2,10 +2,6 @@
 
 #include <QBrush>
 #include <QColor>
-#include <QGraphicsItem>
-#include <QGraphicsRectItem>
-#include <QGraphicsScene>
-#include <QGraphicsView>
 #include <QPainter>
 #include <QPen>
 #include <QPixmap>
@@ -26,7 +22,6 @@
 #include "gameplay/Bonus.h"
 #include "rendering/Camera.h"
 #include "rendering/SpriteManager.h"
-#include "rendering/HudItem.h"
 #include "utils/Constants.h"
 #include "world/Base.h"
 #include "world/Map.h"
@@ -37,16 +32,21 @@ constexpr int kExplosionFrameCount = 3;
 constexpr qreal kExplosionMinScale = 0.35;
 constexpr qreal kExplosionMaxScale = 0.95;
 constexpr qreal kPi = 3.14159265358979323846;
+// Запас навколо кадру: танки й кулі, що от-от заїдуть, уже в списку.
+constexpr int kCullMarginCells = 1;
 } // namespace
 
-Renderer::Renderer(QGraphicsScene* scene)
-    : m_scene(scene)
+Renderer::Renderer(std::unique_ptr<RenderBackend> backend)
+    : m_backend(std::move(backend))
 {
 }
 
+Renderer::~Renderer() = default;
+
 void Renderer::setSpriteManager(SpriteManager* manager)
 {
     m_sprites = manager;
+    m_spritesResolved = false;
 }
 
 void Renderer::setCamera(Camera* camera)
@@ -54,110 +54,104 @@ void Renderer::setCamera(Camera* camera)
     m_camera = camera;
 }
 
+void Renderer::setLayout(RenderLayout* layout)
+{
+    m_layout = layout ? layout : &m_ownLayout;
+    m_layoutVersion = 0;
+}
+
 void Renderer::renderFrame(const Game& game, qreal alpha)
 {
-    if (!m_scene)
+    if (!m_backend)
         return;
 
-    updateRenderTransform(game);
+    m_drawList.clear();
+    updateLayout(game);
+    updateView(game, alpha);
+    // Атлас масштабується лише при зміні розміру тайла; до кінця завантаження — процедурні пензлі.
+    if (m_sprites && m_sprites->prepare(qMax(1, qRound(tileSize()))) && !m_spritesResolved)
+        resolveSprites();
+    m_drawList.viewportSize = m_layout->frameSize();
+    m_drawList.pixelScale = m_layout->pixelScale();
+    m_drawList.layoutVersion = m_viewVersion;
     updateBaseBlinking(game);
-    updateBackground(game);
-    clearMapLayer();     // DEBUG ONLY
+    appendMapFrame(game);
     drawMap(game);       // reflect runtime tile changes
 
-    syncBonuses(game);
-    syncTanks(game, alpha);
-    syncBullets(game, alpha);
-    updateExplosions();
+    appendBonuses(game);
+    appendTanks(game, alpha);
+    appendBullets(game, alpha);
+    appendExplosions();
     updateHud(game);
+
+    m_backend->submit(m_drawList);
 }
 
-void Renderer::updateRenderTransform(const Game& game)
+void Renderer::updateLayout(const Game& game)
 {
-    const Map* map = game.map();
-    if (!m_scene || !map)
-        return;
-
-    QGraphicsView* view = m_scene->views().isEmpty() ? nullptr : m_scene->views().first();
-    if (!view || !view->viewport())
-        return;
+    // Порівняння розмірів дешеве; геометрія перераховується лише коли вони змінились.
+    if (m_layout == &m_ownLayout)
+        m_ownLayout.setViewportSize(m_backend->viewportSize());
+    if (const Map* map = game.map())
+        m_layout->setMapSize(map->size());
 
-    const QSize viewportSize = view->viewport()->size();
-    if (viewportSize.isEmpty())
+    if (m_layoutVersion == m_layout->version())
         return;
-
-    const QSize mapSize = map->size();
-    if (mapSize.isEmpty())
-        return;
-
-    const qreal viewportWidth = static_cast<qreal>(viewportSize.width());
-    const qreal viewportHeight = static_cast<qreal>(viewportSize.height());
-    const qreal mapWidthTiles = static_cast<qreal>(mapSize.width());
-    const qreal mapHeightTiles = static_cast<qreal>(mapSize.height());
-
-    const qreal scale = std::min(viewportWidth / mapWidthTiles, viewportHeight / mapHeightTiles);
-    if (scale <= 0.0)
-        return;
-
-    m_tileScale = scale;
-
-    const qreal mapWidthInPixels = mapWidthTiles * m_tileScale;
-    const qreal mapHeightInPixels = mapHeightTiles * m_tileScale;
-    m_renderOffset = QPointF((viewportWidth - mapWidthInPixels) / 2.0,
-                             (viewportHeight - mapHeightInPixels) / 2.0);
-
-    if (m_camera)
-        m_camera->setTileSize(m_tileScale);
-
-    m_scene->setSceneRect(QRectF(QPointF(0.0, 0.0), QSizeF(viewportSize)));
+    m_layoutVersion = m_layout->version();
+    ++m_viewVersion;
+    rebuildTileBrushes(m_layout->tileSize());
 }
 
-void Renderer::updateBackground(const Game& game)
+void Renderer::updateView(const Game& game, qreal alpha)
 {
-    if (!m_scene)
-        return;
+    const Map* map = game.map();
+    const qreal previousTileSize = m_tileSize;
+    const QPointF previousOffset = m_mapOffset;
+    m_tileSize = m_layout->tileSize();
+    m_mapOffset = m_layout->mapOffset();
+    m_visibleCells = map ? QRect(QPoint(0, 0), map->size()) : QRect();
+    m_cullEnabled = false;
+
+    if (m_camera && m_layout->isValid()) {
+        // Ціль — центр гравця в інтерпольованій позиції; без гравця камера стоїть.
+        const PlayerTank* player = game.player();
+        if (player && !player->isDestroyed()) {
+            const QPointF position = player->previousRenderPosition()
+                                     + (player->renderPosition() - player->previousRenderPosition()) * alpha;
+            m_camera->setTarget(position + QPointF(0.5, 0.5));
+        }
+        m_camera->setViewport(m_layout->frameSize(), m_layout->mapSize(), m_layout->tileSize());
+        // Новий гравець — нова партія: камера стрибає до нього, а не їде через усю карту.
+        if (player != m_cameraTarget) {
+            m_cameraTarget = player;
+            m_camera->snapToTarget();
+        }
 
-    static bool backgroundInitialized = false;
-    if (!backgroundInitialized) {
-        QPixmap pattern(24, 24);
-        pattern.fill(QColor(12, 12, 16));
-        QPainter painter(&pattern);
-        painter.setRenderHint(QPainter::Antialiasing, false);
-        painter.setPen(QColor(22, 22, 28));
-        painter.drawRect(pattern.rect().adjusted(0, 0, -1, -1));
-        painter.drawLine(0, pattern.height() / 2, pattern.width(), pattern.height() / 2);
-        painter.drawLine(pattern.width() / 2, 0, pattern.width() / 2, pattern.height());
-        painter.end();
-        m_scene->setBackgroundBrush(QBrush(pattern));
-        backgroundInitialized = true;
+        m_tileSize = m_camera->tileSize();
+        m_mapOffset = m_camera->offset();
+        m_visibleCells = m_camera->visibleCells(kCullMarginCells);
+        const qreal margin = kCullMarginCells * m_tileSize;
+        m_cullRect = QRectF(QPointF(0.0, 0.0), QSizeF(m_layout->frameSize())).adjusted(-margin, -margin, margin, margin);
+        m_cullEnabled = true;
+        rebuildTileBrushes(m_tileSize);
     }
 
+    if (m_tileSize != previousTileSize || m_mapOffset != previousOffset)
+        ++m_viewVersion;
+}
+
+void Renderer::appendMapFrame(const Game& game)
+{
     const Map* map = game.map();
     if (!map)
         return;
 
-    const QSize mapSize = map->size();
-    if (mapSize.isEmpty())
+    if (map->size().isEmpty())
         return;
 
-    const qreal size = tileSize();
-    const qreal mapWidthInPixels = static_cast<qreal>(mapSize.width()) * size;
-    const qreal mapHeightInPixels = static_cast<qreal>(mapSize.height()) * size;
-    const QRectF mapRect(m_renderOffset, QSizeF(mapWidthInPixels, mapHeightInPixels));
-
-    const qreal frameWidth = std::max(1.0, size * 0.06);
-    const QPen framePen(QColor(70, 70, 80), frameWidth);
-
-    if (!m_mapFrameItem) {
-        m_mapFrameItem = m_scene->addRect(mapRect, framePen, Qt::NoBrush);
-        m_mapFrameItem->setZValue(-10);
-        m_mapFrameItem->setAcceptedMouseButtons(Qt::NoButton);
-        m_mapFrameItem->setAcceptHoverEvents(false);
-        m_mapFrameItem->setFlag(QGraphicsItem::ItemIsFocusable, false);
-    } else {
-        m_mapFrameItem->setRect(mapRect);
-        m_mapFrameItem->setPen(framePen);
-    }
+    m_drawList.hasMap = true;
+    m_drawList.mapRect = QRectF(m_mapOffset, QSizeF(map->size()) * m_tileSize);
+    m_drawList.framePen = m_layout->framePen();
 }
 
 void Renderer::drawMap(const Game& game)
@@ -165,19 +159,17 @@ void Renderer::drawMap(const Game& game)
     const Map* map = game.map();
     if (!map)
         return;
-    rebuildTileBrushes(tileSize());
     const Base* base = game.base();
     const QPoint baseCell = base ? base->cell() : QPoint(-1, -1);
     const bool baseDestroyed = base && base->isDestroyed();
     const bool blinkPhase = m_baseBlinking && ((m_baseBlinkCounter / 8) % 2 == 0);
 
     const qreal size = tileSize();
-    const QSize mapSize = map->size();
-    const qsizetype height = static_cast<qsizetype>(mapSize.height());
-    const qsizetype width = static_cast<qsizetype>(mapSize.width());
+    const qsizetype width = static_cast<qsizetype>(map->size().width());
 
-    for (qsizetype y = 0; y < height; ++y) {
-        for (qsizetype x = 0; x < width; ++x) {
+    // Лише клітинки в кадрі: ціна залежить від розміру вікна, а не карти.
+    for (qsizetype y = m_visibleCells.top(); y <= m_visibleCells.bottom(); ++y) {
+        for (qsizetype x = m_visibleCells.left(); x <= m_visibleCells.right(); ++x) {
             const QPoint cell(static_cast<int>(x), static_cast<int>(y));
             const Tile tile = map->tile(cell);
             if (tile.type == TileType::Empty)
@@ -213,16 +205,18 @@ void Renderer::drawMap(const Game& game)
                 const bool destroyedBaseTile = isBaseCell && baseDestroyed;
                 const bool blinkingBase = isBaseCell && blinkPhase;
                 color = destroyedBaseTile ? QColor(60, 60, 60) : QColor(230, 230, 0);
-                brush = baseTileBrush(destroyedBaseTile, blinkingBase, size);
+                // Фаза блимання лишається процедурною, щоб удар по базі було видно з будь-яким скіном.
+                if (blinkingBase || !spriteBrush(destroyedBaseTile ? m_baseDestroyedSprite : m_baseSprite, &brush))
+                    brush = baseTileBrush(destroyedBaseTile, blinkingBase, size);
+            } else {
+                spriteBrush(m_tileSprites.value(static_cast<int>(tile.type)), &brush);
             }
 
             const QPointF pos = cellToScene(cell);
             QBrush fillBrush = brush;
             if (fillBrush.style() == Qt::NoBrush && fillBrush.texture().isNull())
                 fillBrush = QBrush(color);
-            QGraphicsRectItem* item = m_scene->addRect(QRectF(pos, QSizeF(size, size)), QPen(Qt::NoPen), fillBrush);
-            item->setZValue(zValue);
-            m_mapItems.append(item);
+            appendRect(DrawLayer::Tiles, static_cast<quintptr>(y * width + x), QRectF(pos, QSizeF(size, size)), fillBrush, zValue);
         }
     }
 }
@@ -396,6 +390,41 @@ void Renderer::rebuildTileBrushes(qreal size)
     }));
 }
 
+void Renderer::resolveSprites()
+{
+    m_tileSprites.clear();
+    m_tileSprites.insert(static_cast<int>(TileType::Brick), m_sprites->handle(QStringLiteral("tile.brick")));
+    m_tileSprites.insert(static_cast<int>(TileType::Steel), m_sprites->handle(QStringLiteral("tile.steel")));
+    m_tileSprites.insert(static_cast<int>(TileType::Water), m_sprites->handle(QStringLiteral("tile.water")));
+    m_tileSprites.insert(static_cast<int>(TileType::Ice), m_sprites->handle(QStringLiteral("tile.ice")));
+    m_tileSprites.insert(static_cast<int>(TileType::Forest), m_sprites->handle(QStringLiteral("tile.forest")));
+
+    m_bonusSprites.clear();
+    m_bonusSprites.insert(static_cast<int>(BonusType::Star), m_sprites->handle(QStringLiteral("bonus.star")));
+    m_bonusSprites.insert(static_cast<int>(BonusType::Helmet), m_sprites->handle(QStringLiteral("bonus.helmet")));
+    m_bonusSprites.insert(static_cast<int>(BonusType::Clock), m_sprites->handle(QStringLiteral("bonus.clock")));
+    m_bonusSprites.insert(static_cast<int>(BonusType::Grenade), m_sprites->handle(QStringLiteral("bonus.grenade")));
+
+    m_baseSprite = m_sprites->handle(QStringLiteral("base"));
+    m_baseDestroyedSprite = m_sprites->handle(QStringLiteral("base.destroyed"));
+    for (Direction direction : {Direction::Up, Direction::Down, Direction::Left, Direction::Right}) {
+        m_playerSprites[static_cast<int>(direction)] = m_sprites->handle(QStringLiteral("tank.player"), direction);
+        m_enemySprites[static_cast<int>(direction)] = m_sprites->handle(QStringLiteral("tank.enemy"), direction);
+    }
+    m_spritesResolved = true;
+}
+
+bool Renderer::spriteBrush(SpriteHandle handle, QBrush* brush) const
+{
+    if (!handle.isValid() || !m_sprites || !m_sprites->isReady())
+        return false;
+    const QBrush sprite = m_sprites->brush(handle);
+    if (sprite.style() == Qt::NoBrush)
+        return false;
+    *brush = sprite;
+    return true;
+}
+
 QBrush Renderer::bonusBrush(BonusType type, qreal size)
 {
     const int intSize = qMax(1, qRound(size));
@@ -568,51 +597,25 @@ QBrush Renderer::bonusBrush(BonusType type, qreal size)
     return brush;
 }
 
-void Renderer::syncBonuses(const Game& game)
+void Renderer::appendBonuses(const Game& game)
 {
-    if (!m_scene)
-        return;
-
     const qreal size = tileSize();
     const qreal bonusSize = size * 0.6;
     const QPointF offset((size - bonusSize) / 2.0, (size - bonusSize) / 2.0);
-    QSet<const Bonus*> seen;
 
     for (Bonus* bonus : game.bonuses()) {
         if (!bonus || bonus->isCollected())
             continue;
 
-        seen.insert(bonus);
-        QGraphicsRectItem* item = m_bonusItems.value(bonus, nullptr);
-        if (!item) {
-            item = m_scene->addRect(QRectF(QPointF(0, 0), QSizeF(bonusSize, bonusSize)),
-                                    QPen(Qt::NoPen), bonusBrush(bonus->type(), bonusSize));
-            item->setZValue(8);
-            m_bonusItems.insert(bonus, item);
-        }
-
-        const QBrush brush = bonusBrush(bonus->type(), bonusSize);
-        if (item->brush() != brush)
-            item->setBrush(brush);
-
         const QPointF pos = cellToScene(bonus->cell()) + offset;
-        item->setPos(pos);
-    }
-
-    auto it = m_bonusItems.begin();
-    while (it != m_bonusItems.end()) {
-        if (!seen.contains(it.key())) {
-            QGraphicsItem* item = it.value();
-            m_scene->removeItem(item);
-            delete item;
-            it = m_bonusItems.erase(it);
-        } else {
-            ++it;
-        }
+        QBrush brush;
+        if (!spriteBrush(m_bonusSprites.value(static_cast<int>(bonus->type())), &brush))
+            brush = bonusBrush(bonus->type(), bonusSize);
+        appendRect(DrawLayer::Bonuses, reinterpret_cast<quintptr>(bonus), QRectF(pos, QSizeF(bonusSize, bonusSize)), brush, 8);
     }
 }
 
-void Renderer::syncTanks(const Game& game, qreal alpha)
+void Renderer::appendTanks(const Game& game, qreal alpha)
 {
     const qreal size = tileSize();
     const qreal barrelLength = size * 0.65;
@@ -725,37 +728,10 @@ void Renderer::syncTanks(const Game& game, qreal alpha)
                 m_explosions.append(Explosion{tank->cell(), kExplosionFrameCount, kExplosionFrameCount});
 
             m_destroyedTanks.insert(tank);
-
-            auto removeItemSafely = [&](QGraphicsItem* item, const QString& reason) {
-                if (!item)
-                    return;
-                m_scene->removeItem(item);
-                delete item;
-            };
-
-            QGraphicsRectItem* item = m_tankItems.take(tank);
-            removeItemSafely(item, "Tank destroy");
-
-            QGraphicsRectItem* directionItem = m_tankDirectionItems.take(tank);
-            removeItemSafely(directionItem, "Tank destroy");
-
             continue;
         } else {
             m_destroyedTanks.remove(tank);
         }
-        QGraphicsRectItem* item = m_tankItems.value(tank, nullptr);
-        if (!item) {
-            item = m_scene->addRect(QRectF(QPointF(0, 0), QSizeF(size, size)), QPen(Qt::black), QBrush(QColor(40, 160, 32)));
-            item->setZValue(10);
-            m_tankItems.insert(tank, item);
-        }
-
-        QGraphicsRectItem* directionItem = m_tankDirectionItems.value(tank, nullptr);
-        if (!directionItem) {
-            directionItem = m_scene->addRect(QRectF(QPointF(0, 0), QSizeF(barrelThickness, barrelLength)), QPen(Qt::NoPen), QBrush(Qt::black));
-            directionItem->setZValue(11);
-            m_tankDirectionItems.insert(tank, directionItem);
-        }
 
         QColor bodyColor(40, 160, 32);
         if (tank == game.player()) {
@@ -764,44 +740,22 @@ void Renderer::syncTanks(const Game& game, qreal alpha)
             bodyColor = enemy->currentColor();
         }
 
-        const QBrush tankBrush = tankBrushForColor(bodyColor);
-        if (item->brush() != tankBrush)
-            item->setBrush(tankBrush);
-
         const QColor barrelColor = bodyColor.darker(190);
-        if (directionItem->brush().color() != barrelColor)
-            directionItem->setBrush(QBrush(barrelColor));
-
         const QPointF interpolatedPosition = tank->previousRenderPosition()
                                              + (tank->renderPosition() - tank->previousRenderPosition()) * alpha;
         const QPointF pos = tileToScene(interpolatedPosition);
-        item->setPos(pos);
-        directionItem->setRect(barrelRectForDirection(tank->direction()));
-        directionItem->setPos(pos);
-    }
-
-    auto it = m_tankItems.begin();
-    while (it != m_tankItems.end()) {
-        if (!seen.contains(it.key())) {
-            QGraphicsItem* item = it.value();
-            m_scene->removeItem(item);
-            delete item;
-            it = m_tankItems.erase(it);
-        } else {
-            ++it;
-        }
-    }
-
-    auto dirIt = m_tankDirectionItems.begin();
-    while (dirIt != m_tankDirectionItems.end()) {
-        if (!seen.contains(dirIt.key())) {
-            QGraphicsItem* item = dirIt.value();
-            m_scene->removeItem(item);
-            delete item;
-            dirIt = m_tankDirectionItems.erase(dirIt);
-        } else {
-            ++dirIt;
+        const quintptr key = reinterpret_cast<quintptr>(tank);
+
+        // Спрайт уже містить ствол і повернутий за напрямком, тож окремий прямокутник ствола не потрібен.
+        const int directionIndex = static_cast<int>(tank->direction());
+        const SpriteHandle sprite = tank == game.player() ? m_playerSprites[directionIndex] : m_enemySprites[directionIndex];
+        QBrush spriteFill;
+        if (spriteBrush(sprite, &spriteFill)) {
+            appendRect(DrawLayer::Tanks, key, QRectF(pos, QSizeF(size, size)), spriteFill, 10);
+            continue;
         }
+        appendRect(DrawLayer::Tanks, key, QRectF(pos, QSizeF(size, size)), tankBrushForColor(bodyColor), 10, QPen(Qt::black));
+        appendRect(DrawLayer::Barrels, key, barrelRectForDirection(tank->direction()).translated(pos), QBrush(barrelColor), 11);
     }
 
     auto destroyedIt = m_destroyedTanks.begin();
@@ -813,7 +767,7 @@ void Renderer::syncTanks(const Game& game, qreal alpha)
     }
 }
 
-void Renderer::syncBullets(const Game& game, qreal alpha)
+void Renderer::appendBullets(const Game& game, qreal alpha)
 {
     const Map* map = game.map();
     const qreal size = tileSize();
@@ -835,24 +789,11 @@ void Renderer::syncBullets(const Game& game, qreal alpha)
         const bool vertical = bullet->direction() == Direction::Up || bullet->direction() == Direction::Down;
         const QSizeF bulletShape = vertical ? QSizeF(bulletThickness, bulletLength) : QSizeF(bulletLength, bulletThickness);
         const QPointF bulletOffset((size - bulletShape.width()) / 2.0, (size - bulletShape.height()) / 2.0);
-        QGraphicsRectItem* item = m_bulletItems.value(bullet, nullptr);
-        if (!item) {
-            item = m_scene->addRect(QRectF(QPointF(0, 0), bulletShape), QPen(Qt::NoPen), QBrush(Qt::yellow));
-            item->setZValue(20);
-            m_bulletItems.insert(bullet, item);
-        }
-
-        if (item->rect().size() != bulletShape)
-            item->setRect(QRectF(QPointF(0, 0), bulletShape));
-
         const QColor bulletColor = bullet->canPierceSteel() ? QColor(255, 180, 60) : QColor(255, 235, 80);
-        if (item->brush().color() != bulletColor)
-            item->setBrush(QBrush(bulletColor));
-
         const QPointF interpolatedPosition = bullet->previousRenderPosition()
                                              + (bullet->renderPosition() - bullet->previousRenderPosition()) * alpha;
         const QPointF pos = tileToScene(interpolatedPosition) + bulletOffset;
-        item->setPos(pos);
+        appendRect(DrawLayer::Bullets, reinterpret_cast<quintptr>(bullet), QRectF(pos, bulletShape), QBrush(bulletColor), 20);
         m_lastBulletCells.insert(bullet, bullet->cell());
         m_lastBulletExplosions.insert(bullet, bullet->spawnExplosionOnDestroy());
     }
@@ -868,18 +809,6 @@ void Renderer::syncBullets(const Game& game, qreal alpha)
         }
     }
 
-    auto it = m_bulletItems.begin();
-    while (it != m_bulletItems.end()) {
-        if (!currentBullets.contains(it.key())) {
-            QGraphicsItem* item = it.value();
-            m_scene->removeItem(item);
-            delete item;
-            it = m_bulletItems.erase(it);
-        } else {
-            ++it;
-        }
-    }
-
     auto cellIt = m_lastBulletCells.begin();
     while (cellIt != m_lastBulletCells.end()) {
         if (!currentBullets.contains(cellIt.key()))
@@ -901,25 +830,10 @@ void Renderer::syncBullets(const Game& game, qreal alpha)
 
 void Renderer::updateHud(const Game& game)
 {
-    if (!m_scene)
-        return;
-
     const Map* map = game.map();
     if (!map)
         return;
 
-    const qreal size = tileSize();
-    const qreal hudMargin = size * 0.5;
-    const qreal mapWidthInPixels = static_cast<qreal>(map->size().width()) * size;
-    const qreal hudX = std::min(m_renderOffset.x() + mapWidthInPixels + hudMargin,
-                                m_scene->sceneRect().width() - hudMargin);
-    const QPointF hudPosition(hudX, m_renderOffset.y() + hudMargin);
-
-    if (!m_hudItem) {
-        m_hudItem = new HudItem();
-        m_scene->addItem(m_hudItem);
-    }
-
     const int lives = game.state().remainingLives();
     const int enemyCount = game.state().aliveEnemies();
     const int score = game.state().score();
@@ -937,10 +851,17 @@ void Renderer::updateHud(const Game& game)
         break;
     }
 
-    m_hudItem->setMetrics(lives, stars, maxStars, enemyCount, score, statusText, tileSize());
-
-    if (m_hudItem->pos() != hudPosition)
-        m_hudItem->setPos(hudPosition);
+    HudState& hud = m_drawList.hud;
+    hud.visible = true;
+    hud.position = m_camera ? RenderLayout::hudPositionFor(m_drawList.mapRect, m_layout->frameSize(), m_tileSize)
+                            : m_layout->hudPosition();
+    hud.lives = lives;
+    hud.stars = stars;
+    hud.maxStars = maxStars;
+    hud.enemies = enemyCount;
+    hud.score = score;
+    hud.status = statusText;
+    hud.tileSize = tileSize();
 }
 
 void Renderer::updateBaseBlinking(const Game& game)
@@ -979,49 +900,32 @@ void Renderer::updateBaseBlinking(const Game& game)
     m_lastBaseHealth = currentHealth;
 }
 
-void Renderer::initializeMap(const Game& game)
-{
-    const Map* map = game.map();
-    if (m_cachedMap != map) {
-        clearMapLayer();
-        m_cachedMap = map;
-        drawMap(game);
-    }
-}
-
-void Renderer::clearMapLayer()
-{
-    for (QGraphicsItem* item : m_mapItems) {
-        m_scene->removeItem(item);
-        delete item;
-    }
-    m_mapItems.clear();
-}
-
 QPointF Renderer::cellToScene(const QPoint& cell) const
 {
-    return m_renderOffset + QPointF(cell) * tileSize();
+    return m_mapOffset + QPointF(cell) * tileSize();
 }
 
 QPointF Renderer::tileToScene(const QPointF& tile) const
 {
-    return m_renderOffset + tile * tileSize();
+    return m_mapOffset + tile * tileSize();
 }
 
 qreal Renderer::tileSize() const
 {
-    return m_tileScale;
+    return m_tileSize;
 }
 
-void Renderer::updateExplosions()
+void Renderer::appendRect(DrawLayer layer, quintptr key, const QRectF& rect, const QBrush& brush, qreal z, const QPen& pen)
 {
-    for (QGraphicsRectItem* item : m_explosionItems) {
-        m_scene->removeItem(item);
-        delete item;
-    }
-    m_explosionItems.clear();
+    if (m_cullEnabled && !m_cullRect.intersects(rect))
+        return;
+    m_drawList.rects.append(DrawRect{rect, brush, pen, z, layer, key});
+}
 
+void Renderer::appendExplosions()
+{
     const qreal size = tileSize();
+    quintptr key = 0;
 
     for (Explosion& explosion : m_explosions) {
         if (explosion.ttlFrames <= 0)
@@ -1037,22 +941,16 @@ void Renderer::updateExplosions()
         const QPointF topLeft = center - QPointF(explosionSize / 2.0, explosionSize / 2.0);
 
         const QColor outerColor = QColor::fromRgbF(1.0, 0.8 - 0.25 * frameProgress, 0.25 + 0.2 * frameProgress);
-        QGraphicsRectItem* core = m_scene->addRect(QRectF(topLeft, QSizeF(explosionSize, explosionSize)), QPen(Qt::NoPen), QBrush(outerColor));
-        core->setZValue(25);
-        m_explosionItems.append(core);
+        appendRect(DrawLayer::Explosions, key++, QRectF(topLeft, QSizeF(explosionSize, explosionSize)), QBrush(outerColor), 25);
 
         const qreal flashThickness = explosionSize * 0.35;
         const QBrush flashBrush(QColor(255, 245, 180, 220));
 
         const QPointF horizontalPos(center.x() - explosionSize / 2.0, center.y() - flashThickness / 2.0);
-        QGraphicsRectItem* horizontal = m_scene->addRect(QRectF(horizontalPos, QSizeF(explosionSize, flashThickness)), QPen(Qt::NoPen), flashBrush);
-        horizontal->setZValue(26);
-        m_explosionItems.append(horizontal);
+        appendRect(DrawLayer::Explosions, key++, QRectF(horizontalPos, QSizeF(explosionSize, flashThickness)), flashBrush, 26);
 
         const QPointF verticalPos(center.x() - flashThickness / 2.0, center.y() - explosionSize / 2.0);
-        QGraphicsRectItem* vertical = m_scene->addRect(QRectF(verticalPos, QSizeF(flashThickness, explosionSize)), QPen(Qt::NoPen), flashBrush);
-        vertical->setZValue(26);
-        m_explosionItems.append(vertical);
+        appendRect(DrawLayer::Explosions, key++, QRectF(verticalPos, QSizeF(flashThickness, explosionSize)), flashBrush, 26);
 
         --explosion.ttlFrames;
     }
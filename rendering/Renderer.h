@@ -2,21 +2,24 @@
 #define RENDERER_H
 
 #include <QBrush>
+#include <QPen>
 #include <QHash>
 #include <QList>
 #include <QPoint>
 #include <QPointF>
+#include <QRect>
+#include <QRectF>
 #include <QSet>
+#include <QSize>
 #include <QString>
 #include <QtGlobal>
+#include <memory>
 
+#include "rendering/RenderBackend.h"
+#include "rendering/RenderLayout.h"
+#include "rendering/SpriteManager.h"
 #include "utils/Constants.h"
 
-class QGraphicsScene;
-class QGraphicsItem;
-class QGraphicsRectItem;
-class QGraphicsTextItem;
-class SpriteManager;
 class Camera;
 class Game;
 class Map;
@@ -24,7 +27,6 @@ class Tank;
 class Bullet;
 class Bonus;
 enum class BonusType;
-class HudItem;
 
 struct Explosion
 {
@@ -34,53 +36,65 @@ struct Explosion
 };
 
 /*
- * Renderer відповідає за просту отрисовку кадру на QGraphicsScene.
+ * Renderer перетворює стан Game на DrawList кадру й передає його RenderBackend.
+ * Сам нічого не малює й не тримає елементів сцени: лише кешує пензлі тайлів
+ * і стежить за вибухами та кулями між кадрами. Спрайти з атласу SpriteManager
+ * (тайли, база, бонуси, танки) заміняють процедурні пензлі; чого немає в
+ * маніфесті чи ще не завантажено, малюється як раніше.
  */
 class Renderer
 {
 public:
-    explicit Renderer(QGraphicsScene* scene);
+    explicit Renderer(std::unique_ptr<RenderBackend> backend);
+    ~Renderer();
 
     void setSpriteManager(SpriteManager* manager);
     void setCamera(Camera* camera);
+    // Геометрію веде власник вікна (див. MainWindow::resizeEvent); nullptr — Renderer
+    // сам звіряє розмір бекенду щокадру, як для кадрів без вікна.
+    void setLayout(RenderLayout* layout);
 
     void renderFrame(const Game& game, qreal alpha);
 
 private:
-    void initializeMap(const Game& game);
+    void appendMapFrame(const Game& game);
     void drawMap(const Game& game);
-    void syncBonuses(const Game& game);
-    void syncTanks(const Game& game, qreal alpha);
-    void syncBullets(const Game& game, qreal alpha);
-    void updateExplosions();
+    void appendBonuses(const Game& game);
+    void appendTanks(const Game& game, qreal alpha);
+    void appendBullets(const Game& game, qreal alpha);
+    void appendExplosions();
     void updateHud(const Game& game);
     void updateBaseBlinking(const Game& game);
-    void updateRenderTransform(const Game& game);
-    void updateBackground(const Game& game);
+    void updateLayout(const Game& game);
+    void updateView(const Game& game, qreal alpha);
     QPointF cellToScene(const QPoint& cell) const;
     QPointF tileToScene(const QPointF& tile) const;
-    void clearMapLayer();
+    void appendRect(DrawLayer layer, quintptr key, const QRectF& rect, const QBrush& brush, qreal z, const QPen& pen = QPen(Qt::NoPen));
     qreal tileSize() const;
     QBrush tileBrush(int tileType, qreal size);
     QBrush baseTileBrush(bool destroyed, bool blinkPhase, qreal size);
     QBrush bonusBrush(BonusType type, qreal size);
     void rebuildTileBrushes(qreal size);
+    void resolveSprites();
+    bool spriteBrush(SpriteHandle handle, QBrush* brush) const;
 
-    QGraphicsScene* m_scene = nullptr;
+    std::unique_ptr<RenderBackend> m_backend;
     SpriteManager* m_sprites = nullptr;
     Camera* m_camera = nullptr;
 
-    const Map* m_cachedMap = nullptr;
-    QList<QGraphicsItem*> m_mapItems;
-    QHash<const Tank*, QGraphicsRectItem*> m_tankItems;
-    QHash<const Tank*, QGraphicsRectItem*> m_tankDirectionItems;
-    QHash<const Bullet*, QGraphicsRectItem*> m_bulletItems;
-    QHash<const Bonus*, QGraphicsRectItem*> m_bonusItems;
-    QList<QGraphicsRectItem*> m_explosionItems;
-    HudItem* m_hudItem = nullptr;
-    QGraphicsRectItem* m_mapFrameItem = nullptr;
-    QPointF m_renderOffset{0.0, 0.0};
-    qreal m_tileScale = TILE_SIZE;
+    DrawList m_drawList;
+    RenderLayout m_ownLayout;
+    RenderLayout* m_layout = &m_ownLayout;
+    quint64 m_layoutVersion = 0;    // версія, під яку зібрані пензлі тайлів і камера
+    quint64 m_viewVersion = 0;      // DrawList::layoutVersion: RenderLayout або рух камери
+
+    // Поточний вид: з камерою — її тайл і зсув, без неї — вся карта за RenderLayout.
+    qreal m_tileSize = TILE_SIZE;
+    QPointF m_mapOffset{0.0, 0.0};
+    QRect m_visibleCells;
+    QRectF m_cullRect;              // пікселі кадру з запасом; поза ним прямокутники не додаються
+    bool m_cullEnabled = false;
+    const Tank* m_cameraTarget = nullptr;
 
     bool m_baseBlinking = false;
     int m_baseBlinkCounter = 0;
@@ -94,6 +108,15 @@ private:
 
     QHash<int, QBrush> m_tileBrushes;
     int m_tileBrushSize = 0;
+
+    // Дескриптори шукаються за ключем один раз після завантаження атласу.
+    bool m_spritesResolved = false;
+    QHash<int, SpriteHandle> m_tileSprites;     // TileType → спрайт
+    QHash<int, SpriteHandle> m_bonusSprites;    // BonusType → спрайт
+    SpriteHandle m_baseSprite;
+    SpriteHandle m_baseDestroyedSprite;
+    SpriteHandle m_playerSprites[4];            // за Direction
+    SpriteHandle m_enemySprites[4];
 };
 
 #endif // RENDERER_H
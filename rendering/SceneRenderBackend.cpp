@@ -0,0 +1,176 @@
+#include "rendering/SceneRenderBackend.h"
+
+#include <QGraphicsRectItem>
+#include <QGraphicsScene>
+#include <QGraphicsView>
+
+#include "rendering/DrawBatchItem.h"
+#include "rendering/HudItem.h"
+
+SceneRenderBackend::SceneRenderBackend(QGraphicsScene* scene)
+    : m_scene(scene)
+{
+}
+
+SceneRenderBackend::~SceneRenderBackend()
+{
+    // Сцена може пережити бекенд (вона — дитина вікна), тож прибираємо свої елементи самі.
+    if (!m_scene)
+        return;
+
+    for (auto& items : m_items) {
+        for (const SceneEntry& entry : std::as_const(items)) {
+            m_scene->removeItem(entry.item);
+            delete entry.item;
+        }
+        items.clear();
+    }
+    for (DrawBatchItem*& batch : m_batches) {
+        delete batch;
+        batch = nullptr;
+    }
+    delete m_mapFrameItem;
+    delete m_hudItem;
+}
+
+QSize SceneRenderBackend::viewportSize() const
+{
+    if (!m_scene)
+        return QSize();
+
+    QGraphicsView* view = m_scene->views().isEmpty() ? nullptr : m_scene->views().first();
+    if (!view || !view->viewport())
+        return QSize();
+    return view->viewport()->size();
+}
+
+void SceneRenderBackend::submit(const DrawList& list)
+{
+    if (!m_scene)
+        return;
+
+    if (!m_backgroundSet) {
+        m_scene->setBackgroundBrush(backgroundBrush());
+        m_backgroundSet = true;
+    }
+    // Розмір сцени й рамка поля залежать лише від геометрії кадру, тож оновлюються зі зміною її версії.
+    const bool layoutChanged = list.layoutVersion != m_layoutVersion;
+    m_layoutVersion = list.layoutVersion;
+    if (layoutChanged && !list.viewportSize.isEmpty())
+        m_scene->setSceneRect(QRectF(QPointF(0.0, 0.0), QSizeF(list.viewportSize * list.pixelScale)));
+
+    if (list.hasMap) {
+        if (!m_mapFrameItem) {
+            m_mapFrameItem = m_scene->addRect(list.mapRect, list.framePen, Qt::NoBrush);
+            m_mapFrameItem->setZValue(-10);
+            m_mapFrameItem->setAcceptedMouseButtons(Qt::NoButton);
+            m_mapFrameItem->setAcceptHoverEvents(false);
+            m_mapFrameItem->setFlag(QGraphicsItem::ItemIsFocusable, false);
+        } else if (layoutChanged) {
+            m_mapFrameItem->setRect(list.mapRect);
+            m_mapFrameItem->setPen(list.framePen);
+        }
+    }
+
+    ++m_frame;
+    for (DrawBatchItem* batch : m_batches) {
+        if (batch)
+            batch->clear();
+    }
+    for (const DrawRect& rect : list.rects) {
+        if (isBatchedLayer(rect.layer))
+            batchItem(rect.layer)->append(rect);
+        else
+            syncRect(rect);
+    }
+    for (DrawBatchItem* batch : m_batches) {
+        if (batch)
+            batch->commit();
+    }
+    removeStaleItems();
+    syncHud(list.hud);
+}
+
+bool SceneRenderBackend::isBatchedLayer(DrawLayer layer)
+{
+    switch (layer) {
+    case DrawLayer::Tanks:
+    case DrawLayer::Barrels:
+    case DrawLayer::Bullets:
+    case DrawLayer::Explosions:
+        return true;
+    case DrawLayer::Tiles:
+    case DrawLayer::Bonuses:
+        break;
+    }
+    return false;
+}
+
+DrawBatchItem* SceneRenderBackend::batchItem(DrawLayer layer)
+{
+    DrawBatchItem*& batch = m_batches[static_cast<int>(layer)];
+    if (!batch) {
+        batch = new DrawBatchItem();
+        m_scene->addItem(batch);
+    }
+    return batch;
+}
+
+void SceneRenderBackend::syncRect(const DrawRect& rect)
+{
+    // Прямокутник елемента завжди починається в (0, 0), а положення задає pos:
+    // так текстура пензля вирівняна по самому елементу, а рух не змінює геометрію.
+    SceneEntry& entry = m_items[static_cast<int>(rect.layer)][rect.key];
+    const QRectF localRect(QPointF(0.0, 0.0), rect.rect.size());
+    if (!entry.item) {
+        entry.item = m_scene->addRect(localRect, rect.pen, rect.brush);
+        entry.item->setZValue(rect.z);
+        entry.item->setPos(rect.rect.topLeft());
+    } else {
+        if (entry.item->rect() != localRect)
+            entry.item->setRect(localRect);
+        if (entry.item->brush() != rect.brush)
+            entry.item->setBrush(rect.brush);
+        if (entry.item->pen() != rect.pen)
+            entry.item->setPen(rect.pen);
+        if (entry.item->zValue() != rect.z)
+            entry.item->setZValue(rect.z);
+        if (entry.item->pos() != rect.rect.topLeft())
+            entry.item->setPos(rect.rect.topLeft());
+    }
+    entry.frame = m_frame;
+}
+
+void SceneRenderBackend::removeStaleItems()
+{
+    for (auto& items : m_items) {
+        auto it = items.begin();
+        while (it != items.end()) {
+            if (it->frame == m_frame) {
+                ++it;
+                continue;
+            }
+            m_scene->removeItem(it->item);
+            delete it->item;
+            it = items.erase(it);
+        }
+    }
+}
+
+void SceneRenderBackend::syncHud(const HudState& hud)
+{
+    if (!hud.visible) {
+        if (m_hudItem)
+            m_hudItem->setVisible(false);
+        return;
+    }
+
+    if (!m_hudItem) {
+        m_hudItem = new HudItem();
+        m_scene->addItem(m_hudItem);
+    }
+    m_hudItem->setVisible(true);
+    m_hudItem->setMetrics(hud.lives, hud.stars, hud.maxStars, hud.enemies, hud.score, hud.status, hud.tileSize);
+    if (m_hudItem->pos() != hud.position)
+        m_hudItem->setPos(hud.position);
+}
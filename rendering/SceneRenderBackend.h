@@ -0,0 +1,54 @@
+#ifndef SCENERENDERBACKEND_H
+#define SCENERENDERBACKEND_H
+
+#include <QHash>
+#include <QtGlobal>
+
+#include "rendering/RenderBackend.h"
+
+class QGraphicsRectItem;
+class QGraphicsScene;
+class DrawBatchItem;
+class HudItem;
+
+/*
+ * SceneRenderBackend — початковий шлях через QGraphicsScene. Статичні шари
+ * (тайли, бонуси) тримають QGraphicsRectItem на кожен DrawRect за ключем (шар, key):
+ * елемент створюється при першій появі, оновлюється лише змінними властивостями
+ * й видаляється, коли зникає зі списку. Рухомі шари (танки, стволи, кулі, вибухи)
+ * змінюються щокадру, тож кожен із них — один DrawBatchItem, що малює весь шар
+ * одним викликом. Меню та редактор лишаються на тій самій сцені.
+ */
+class SceneRenderBackend : public RenderBackend
+{
+public:
+    explicit SceneRenderBackend(QGraphicsScene* scene);
+    ~SceneRenderBackend() override;
+
+    QSize viewportSize() const override;
+    void submit(const DrawList& list) override;
+
+private:
+    struct SceneEntry
+    {
+        QGraphicsRectItem* item = nullptr;
+        quint32 frame = 0;
+    };
+
+    static bool isBatchedLayer(DrawLayer layer);
+    void syncRect(const DrawRect& rect);
+    DrawBatchItem* batchItem(DrawLayer layer);
+    void removeStaleItems();
+    void syncHud(const HudState& hud);
+
+    QGraphicsScene* m_scene = nullptr;
+    QHash<quintptr, SceneEntry> m_items[kDrawLayerCount];
+    DrawBatchItem* m_batches[kDrawLayerCount] = {};
+    QGraphicsRectItem* m_mapFrameItem = nullptr;
+    HudItem* m_hudItem = nullptr;
+    quint32 m_frame = 0;
+    quint64 m_layoutVersion = 0;
+    bool m_backgroundSet = false;
+};
+
+#endif // SCENERENDERBACKEND_H
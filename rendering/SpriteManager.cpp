@@ -1,11 +1,378 @@
 #include "rendering/SpriteManager.h"
 
-void SpriteManager::registerSprite(const QString& key, const QString& path)
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QTransform>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Рамка з повтором крайніх пікселів навколо кожного спрайта в атласі.
+constexpr int kGutter = 1;
+constexpr int kMaxAtlasWidth = 2048;
+
+const char* const kDirectionSuffixes[] = {"/up", "/down", "/left", "/right"};
+
+// Номер напрямку за годинниковою стрілкою від «вгору».
+int clockwiseIndex(Direction direction)
+{
+    switch (direction) {
+    case Direction::Up: return 0;
+    case Direction::Right: return 1;
+    case Direction::Down: return 2;
+    case Direction::Left: return 3;
+    }
+    return 0;
+}
+
+QString directionalKey(const QString& key, Direction direction)
+{
+    return key + QLatin1String(kDirectionSuffixes[static_cast<int>(direction)]);
+}
+
+bool parseDirection(const QString& text, Direction* direction)
+{
+    static const QHash<QString, Direction> kNames = {
+        {QStringLiteral("up"), Direction::Up},
+        {QStringLiteral("down"), Direction::Down},
+        {QStringLiteral("left"), Direction::Left},
+        {QStringLiteral("right"), Direction::Right},
+    };
+    const auto it = kNames.constFind(text);
+    if (it == kNames.constEnd())
+        return false;
+    *direction = it.value();
+    return true;
+}
+
+bool fail(QString* error, const QString& message)
+{
+    if (error)
+        *error = message;
+    return false;
+}
+
+// Пакування полицями: спрайти від найвищого, рядок за рядком. Повертає внутрішні
+// прямокутники (без рамки); порожній розмір лишає порожній прямокутник.
+QVector<QRect> packShelves(const QVector<QSize>& sizes, QSize* atlasSize)
+{
+    qint64 area = 0;
+    int widest = 0;
+    for (const QSize& size : sizes) {
+        if (size.isEmpty())
+            continue;
+        area += static_cast<qint64>(size.width() + 2 * kGutter) * (size.height() + 2 * kGutter);
+        widest = qMax(widest, size.width() + 2 * kGutter);
+    }
+    const int width = qMax(widest, qMin(kMaxAtlasWidth, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area))))));
+
+    QVector<int> order;
+    order.reserve(sizes.size());
+    for (int i = 0; i < sizes.size(); ++i) {
+        if (!sizes.at(i).isEmpty())
+            order.append(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&sizes](int a, int b) {
+        return sizes.at(a).height() > sizes.at(b).height();
+    });
+
+    QVector<QRect> rects(sizes.size());
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    for (const int index : std::as_const(order)) {
+        const QSize cell = sizes.at(index) + QSize(2 * kGutter, 2 * kGutter);
+        if (x + cell.width() > width) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        rects[index] = QRect(QPoint(x + kGutter, y + kGutter), sizes.at(index));
+        x += cell.width();
+        shelfHeight = qMax(shelfHeight, cell.height());
+    }
+    *atlasSize = QSize(qMax(1, width), qMax(1, y + shelfHeight));
+    return rects;
+}
+
+// Спрайт і його рамка: крайні рядки, стовпці й кути повторюються назовні.
+void drawWithGutter(QPainter& painter, const QImage& sprite, const QRect& target)
+{
+    const int w = sprite.width();
+    const int h = sprite.height();
+    painter.drawImage(target.topLeft(), sprite);
+    painter.drawImage(QRect(target.left() - 1, target.top(), 1, h), sprite, QRect(0, 0, 1, h));
+    painter.drawImage(QRect(target.right() + 1, target.top(), 1, h), sprite, QRect(w - 1, 0, 1, h));
+    painter.drawImage(QRect(target.left(), target.top() - 1, w, 1), sprite, QRect(0, 0, w, 1));
+    painter.drawImage(QRect(target.left(), target.bottom() + 1, w, 1), sprite, QRect(0, h - 1, w, 1));
+    painter.drawImage(target.topLeft() - QPoint(1, 1), sprite, QRect(0, 0, 1, 1));
+    painter.drawImage(target.topRight() + QPoint(1, -1), sprite, QRect(w - 1, 0, 1, 1));
+    painter.drawImage(target.bottomLeft() + QPoint(-1, 1), sprite, QRect(0, h - 1, 1, 1));
+    painter.drawImage(target.bottomRight() + QPoint(1, 1), sprite, QRect(w - 1, h - 1, 1, 1));
+}
+
+QImage composeAtlas(const QVector<QImage>& sprites, QVector<QRect>* rects)
+{
+    QVector<QSize> sizes(sprites.size());
+    for (int i = 0; i < sprites.size(); ++i)
+        sizes[i] = sprites.at(i).size();
+
+    QSize atlasSize;
+    *rects = packShelves(sizes, &atlasSize);
+    QImage atlas(atlasSize, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    QPainter painter(&atlas);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (int i = 0; i < sprites.size(); ++i) {
+        if (!rects->at(i).isEmpty())
+            drawWithGutter(painter, sprites.at(i), rects->at(i));
+    }
+    painter.end();
+    return atlas;
+}
+} // namespace
+
+SpriteManager::SpriteManager() = default;
+
+SpriteManager::~SpriteManager()
+{
+    // Задача працює з власною копією списку, але не лишаємо декодування після знищення.
+    if (m_loadPending)
+        m_loading.waitForFinished();
+}
+
+SpriteHandle SpriteManager::registerSprite(const QString& key, const QString& path, const QRect& source,
+                                           const QSizeF& tiles, bool keepAspect)
+{
+    Entry entry;
+    entry.key = key;
+    entry.path = path;
+    entry.source = source;
+    entry.tiles = tiles;
+    entry.keepAspect = keepAspect;
+
+    const auto existing = m_index.constFind(key);
+    if (existing != m_index.constEnd()) {
+        m_entries[existing.value()] = entry;
+        return SpriteHandle{existing.value()};
+    }
+    m_entries.append(entry);
+    const int index = static_cast<int>(m_entries.size() - 1);
+    m_index.insert(key, index);
+    return SpriteHandle{index};
+}
+
+void SpriteManager::registerDirectionalSprite(const QString& key, const QString& path, Direction facing,
+                                              const QRect& source, const QSizeF& tiles, bool keepAspect)
+{
+    for (Direction direction : {Direction::Up, Direction::Down, Direction::Left, Direction::Right}) {
+        const SpriteHandle handle = registerSprite(directionalKey(key, direction), path, source, tiles, keepAspect);
+        m_entries[handle.index].quarterTurns = (clockwiseIndex(direction) - clockwiseIndex(facing) + 4) % 4;
+    }
+}
+
+bool SpriteManager::loadManifest(const QString& filePath, QString* error)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return fail(error, file.errorString());
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+    if (!document.isObject())
+        return fail(error, QStringLiteral("manifest is not a JSON object"));
+
+    const QDir baseDir = QFileInfo(filePath).absoluteDir();
+    const QJsonArray sprites = document.object().value(QStringLiteral("sprites")).toArray();
+    for (const QJsonValue& value : sprites) {
+        const QJsonObject object = value.toObject();
+        const QString key = object.value(QStringLiteral("key")).toString();
+        const QString fileName = object.value(QStringLiteral("file")).toString();
+        if (key.isEmpty() || fileName.isEmpty())
+            return fail(error, QStringLiteral("sprite entry without key or file"));
+
+        QRect source;
+        const QJsonArray rect = object.value(QStringLiteral("rect")).toArray();
+        if (rect.size() == 4)
+            source = QRect(rect.at(0).toInt(), rect.at(1).toInt(), rect.at(2).toInt(), rect.at(3).toInt());
+        QSizeF tiles(1.0, 1.0);
+        const QJsonArray span = object.value(QStringLiteral("tiles")).toArray();
+        if (span.size() == 2)
+            tiles = QSizeF(span.at(0).toDouble(1.0), span.at(1).toDouble(1.0));
+        const bool keepAspect = object.value(QStringLiteral("keepAspect")).toBool(false);
+        const QString path = baseDir.filePath(fileName);
+
+        const QString facingName = object.value(QStringLiteral("facing")).toString();
+        if (facingName.isEmpty()) {
+            registerSprite(key, path, source, tiles, keepAspect);
+            continue;
+        }
+        Direction facing = Direction::Up;
+        if (!parseDirection(facingName, &facing))
+            return fail(error, QStringLiteral("%1: unknown facing \"%2\"").arg(key, facingName));
+        registerDirectionalSprite(key, path, facing, source, tiles, keepAspect);
+    }
+    return true;
+}
+
+QString SpriteManager::defaultManifestPath()
 {
-    m_sprites.insert(key, path);
+    const QString relativePath = QStringLiteral("assets/sprites/sprites.json");
+    const QStringList roots = {QDir::currentPath(), QCoreApplication::applicationDirPath()};
+    for (const QString& root : roots) {
+        for (const QString& prefix : {QString(), QStringLiteral("../"), QStringLiteral("../../"), QStringLiteral("../../../")}) {
+            const QString candidate = QDir(root).absoluteFilePath(prefix + relativePath);
+            if (QFileInfo::exists(candidate))
+                return candidate;
+        }
+    }
+    return QDir::current().absoluteFilePath(relativePath);
 }
 
 QString SpriteManager::spritePath(const QString& key) const
 {
-    return m_sprites.value(key);
+    const auto it = m_index.constFind(key);
+    return it == m_index.constEnd() ? QString() : m_entries.at(it.value()).path;
+}
+
+void SpriteManager::loadAsync()
+{
+    if (m_loadPending)
+        m_loading.waitForFinished();
+    const QVector<Entry> entries = m_entries;
+    m_loading = QtConcurrent::run([entries]() { return buildNativeAtlas(entries); });
+    m_loadPending = true;
+}
+
+void SpriteManager::waitForLoaded()
+{
+    if (m_loadPending)
+        m_loading.waitForFinished();
+    takeLoadedAtlas();
+}
+
+bool SpriteManager::prepare(int tilePixels)
+{
+    takeLoadedAtlas();
+    if (!m_native || tilePixels <= 0)
+        return isReady();
+    if (tilePixels != m_tileSize)
+        rebuildScaled(tilePixels);
+    return isReady();
+}
+
+SpriteHandle SpriteManager::handle(const QString& key) const
+{
+    const auto it = m_index.constFind(key);
+    return it == m_index.constEnd() ? SpriteHandle() : SpriteHandle{it.value()};
+}
+
+SpriteHandle SpriteManager::handle(const QString& key, Direction direction) const
+{
+    return handle(directionalKey(key, direction));
+}
+
+QRect SpriteManager::sourceRect(SpriteHandle handle) const
+{
+    if (handle.index < 0 || handle.index >= m_scaledRects.size())
+        return QRect();
+    return m_scaledRects.at(handle.index);
+}
+
+QBrush SpriteManager::brush(SpriteHandle handle) const
+{
+    if (handle.index < 0 || handle.index >= m_brushes.size())
+        return QBrush();
+    return m_brushes.at(handle.index);
+}
+
+std::shared_ptr<SpriteManager::NativeAtlas> SpriteManager::buildNativeAtlas(const QVector<Entry>& entries)
+{
+    // Аркуш декодується один раз, навіть якщо з нього вирізано багато спрайтів.
+    QHash<QString, QImage> sheets;
+    QVector<QImage> sprites(entries.size());
+    for (int i = 0; i < entries.size(); ++i) {
+        const Entry& entry = entries.at(i);
+        auto sheet = sheets.find(entry.path);
+        if (sheet == sheets.end())
+            sheet = sheets.insert(entry.path, QImage(entry.path).convertToFormat(QImage::Format_ARGB32_Premultiplied));
+        if (sheet.value().isNull())
+            continue;
+
+        const QRect source = entry.source.isNull() ? sheet.value().rect() : entry.source & sheet.value().rect();
+        if (source.isEmpty())
+            continue;
+        QImage sprite = sheet.value().copy(source);
+        if (entry.quarterTurns != 0)
+            sprite = sprite.transformed(QTransform().rotate(90.0 * entry.quarterTurns));
+        sprites[i] = sprite;
+    }
+
+    auto atlas = std::make_shared<NativeAtlas>();
+    atlas->image = composeAtlas(sprites, &atlas->rects);
+    return atlas;
+}
+
+void SpriteManager::takeLoadedAtlas()
+{
+    if (!m_loadPending || !m_loading.isFinished())
+        return;
+    m_loadPending = false;
+    m_native = m_loading.result();
+    m_tileSize = 0;     // новий атлас — масштабуємо заново при наступному prepare()
+}
+
+void SpriteManager::rebuildScaled(int tilePixels)
+{
+    const qsizetype count = qMin(m_entries.size(), m_native->rects.size());
+    QVector<QImage> sprites(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        const QRect nativeRect = m_native->rects.at(i);
+        if (nativeRect.isEmpty())
+            continue;
+
+        const Entry& entry = m_entries.at(i);
+        // tiles задано для зображення у файлі, тож поворот на чверть міняє сторони місцями.
+        QSize cell(qMax(1, qRound(entry.tiles.width() * tilePixels)), qMax(1, qRound(entry.tiles.height() * tilePixels)));
+        if (entry.quarterTurns % 2 != 0)
+            cell.transpose();
+        const QImage native = m_native->image.copy(nativeRect);
+        if (!entry.keepAspect) {
+            sprites[i] = native.scaled(cell, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+            continue;
+        }
+
+        const QSize fitted = native.size().scaled(cell, Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+        QImage canvas(cell, QImage::Format_ARGB32_Premultiplied);
+        canvas.fill(Qt::transparent);
+        QPainter painter(&canvas);
+        painter.drawImage(QPoint((cell.width() - fitted.width()) / 2, (cell.height() - fitted.height()) / 2),
+                          native.scaled(fitted, Qt::IgnoreAspectRatio, Qt::FastTransformation));
+        painter.end();
+        sprites[i] = canvas;
+    }
+
+    const QImage scaled = composeAtlas(sprites, &m_scaledRects);
+    m_scaled = QPixmap::fromImage(scaled);
+    m_tileSize = tilePixels;
+    ++m_revision;
+
+    // Пензель спрайта — увесь атлас, зсунутий так, щоб прямокутник спрайта починався в (0, 0)
+    // пензля; бекенди прив'язують текстуру до кута DrawRect.
+    m_brushes.resize(m_scaledRects.size());
+    for (qsizetype i = 0; i < m_scaledRects.size(); ++i) {
+        const QRect rect = m_scaledRects.at(i);
+        if (rect.isEmpty()) {
+            m_brushes[i] = QBrush();
+            continue;
+        }
+        QBrush brush(m_scaled);
+        brush.setTransform(QTransform::fromTranslate(-rect.x(), -rect.y()));
+        m_brushes[i] = brush;
+    }
 }
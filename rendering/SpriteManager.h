@@ -1,20 +1,109 @@
 #ifndef SPRITEMANAGER_H
 #define SPRITEMANAGER_H
 
-#include <QString>
+#include <QBrush>
+#include <QFuture>
 #include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QRect>
+#include <QSizeF>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <memory>
+
+#include "gameplay/Direction.h"
+
+// Легкий дескриптор спрайта: індекс у таблиці SpriteManager, стабільний після реєстрації.
+struct SpriteHandle
+{
+    int index = -1;
+    bool isValid() const { return index >= 0; }
+};
 
 /*
- * SpriteManager зберігає шляхи до текстур і анімацій.
+ * SpriteManager завантажує спрайти з аркушів і пакує їх в один атлас.
+ * Список спрайтів береться з маніфесту assets/sprites/sprites.json (ключ, файл,
+ * прямокутник на аркуші, розмір у тайлах, напрямок, куди дивиться зображення),
+ * тож новий скін — це PNG і рядок маніфесту, без коду.
+ * loadAsync() декодує файли й пакує атлас у робочому потоці (QtConcurrent), а
+ * prepare() на GUI-потоці забирає готовий результат і для поточного розміру тайла
+ * будує масштабований атлас: кожен спрайт зменшується чи збільшується найближчим
+ * сусідом до цілого числа пікселів і отримує рамку в 1 піксель з повтором краю,
+ * щоби дробові координати не захоплювали сусіда. Повторна побудова — лише при зміні розміру.
+ * brush() повертає пензель, що посилається на спільний атлас зі зсувом на свій
+ * прямокутник, тож обидва бекенди малюють спрайт як звичайну текстуру.
  */
 class SpriteManager
 {
 public:
-    void registerSprite(const QString& key, const QString& path);
+    SpriteManager();
+    ~SpriteManager();
+    SpriteManager(const SpriteManager&) = delete;
+    SpriteManager& operator=(const SpriteManager&) = delete;
+
+    // tiles — розмір на полі в тайлах; keepAspect — вписати зі збереженням пропорцій
+    // замість розтягування. Реєстрація після loadAsync() діє з наступним завантаженням.
+    SpriteHandle registerSprite(const QString& key, const QString& path, const QRect& source = QRect(),
+                                const QSizeF& tiles = QSizeF(1.0, 1.0), bool keepAspect = false);
+    // Чотири повернуті варіанти одного зображення; facing — куди воно дивиться у файлі.
+    void registerDirectionalSprite(const QString& key, const QString& path, Direction facing,
+                                   const QRect& source = QRect(), const QSizeF& tiles = QSizeF(1.0, 1.0),
+                                   bool keepAspect = false);
+    bool loadManifest(const QString& filePath, QString* error = nullptr);
+    // assets/sprites/sprites.json поруч із робочим каталогом або застосунком.
+    static QString defaultManifestPath();
     QString spritePath(const QString& key) const;
 
+    void loadAsync();
+    void waitForLoaded();
+    // Забирає готовий атлас і масштабує його під tilePixels; false — спрайтів ще немає.
+    bool prepare(int tilePixels);
+    bool isReady() const { return !m_scaled.isNull(); }
+    // Змінюється з кожним новим масштабованим атласом: кеші пензлів звіряються з ним.
+    quint64 revision() const { return m_revision; }
+
+    SpriteHandle handle(const QString& key) const;
+    SpriteHandle handle(const QString& key, Direction direction) const;
+    QRect sourceRect(SpriteHandle handle) const;
+    const QPixmap& atlas() const { return m_scaled; }
+    QBrush brush(SpriteHandle handle) const;
+    int tileSize() const { return m_tileSize; }
+
 private:
-    QHash<QString, QString> m_sprites;
+    struct Entry
+    {
+        QString key;
+        QString path;
+        QRect source;           // порожній — увесь файл
+        QSizeF tiles;
+        bool keepAspect = false;
+        int quarterTurns = 0;   // поворот за годинниковою стрілкою на 90° від файлу
+    };
+
+    // Атлас у рідному розмірі: результат робочого потоку.
+    struct NativeAtlas
+    {
+        QImage image;
+        QVector<QRect> rects;   // за індексом Entry; порожній — файл не прочитався
+    };
+
+    static std::shared_ptr<NativeAtlas> buildNativeAtlas(const QVector<Entry>& entries);
+    void takeLoadedAtlas();
+    void rebuildScaled(int tilePixels);
+
+    QVector<Entry> m_entries;
+    QHash<QString, int> m_index;
+    QFuture<std::shared_ptr<NativeAtlas>> m_loading;
+    bool m_loadPending = false;
+    std::shared_ptr<NativeAtlas> m_native;
+
+    QPixmap m_scaled;
+    QVector<QRect> m_scaledRects;
+    QVector<QBrush> m_brushes;
+    int m_tileSize = 0;
+    quint64 m_revision = 0;
 };
 
 #endif // SPRITEMANAGER_H
@@ -3,6 +3,11 @@
 #include <algorithm>
 #include <Qt>
 
+namespace {
+constexpr quint8 kDirectionMask = 0x07;
+constexpr quint8 kFireBit = 0x08;
+}
+
 std::optional<Direction> InputSystem::directionFromScanCode(quint32 scanCode)
 {
     switch (scanCode) {
@@ -110,6 +115,25 @@ void InputSystem::clear()
     m_fireRequested = false;
 }
 
+quint8 InputSystem::snapshot() const
+{
+    quint8 value = 0;
+    if (const std::optional<Direction> dir = currentDirection())
+        value = static_cast<quint8>(static_cast<int>(*dir) + 1);
+    if (m_fireRequested)
+        value |= kFireBit;
+    return value;
+}
+
+void InputSystem::restore(quint8 snapshot)
+{
+    m_pressedDirections.clear();
+    const int direction = snapshot & kDirectionMask;
+    if (direction >= 1 && direction <= static_cast<int>(Direction::Right) + 1)
+        m_pressedDirections.push_back(static_cast<Direction>(direction - 1));
+    m_fireRequested = (snapshot & kFireBit) != 0;
+}
+
 void InputSystem::pushDirection(Direction dir)
 {
     const auto it = std::find(m_pressedDirections.begin(), m_pressedDirections.end(), dir);
@@ -24,6 +24,11 @@ public:
     bool consumeFire();
     void clear();
 
+    // Стан на початку тіку в одному байті: біти 0–2 — напрямок (0 — немає, інакше Direction + 1),
+    // біт 3 — запит пострілу. SessionRecording пише ці байти, відтворення повертає їх через restore().
+    quint8 snapshot() const;
+    void restore(quint8 snapshot);
+
 private:
     static std::optional<Direction> directionFromKey(int key);
     void pushDirection(Direction dir);
@@ -10,6 +10,7 @@
 #include <QKeyEvent>
 #include <QPen>
 #include <QPointF>
+#include <QRandomGenerator>
 #include <QtGlobal>
 #include <QSizeF>
 #include <QStringList>
@@ -17,8 +18,37 @@
 
 #include "core/Game.h"
 #include "systems/InputSystem.h"
+#include "world/LevelIndex.h"
 #include "world/LevelLoader.h"
 
+namespace {
+const QFont& menuTitleFont()
+{
+    static const QFont font = [] {
+        QFont titleFont;
+        titleFont.setPointSize(34);
+        titleFont.setBold(true);
+        return titleFont;
+    }();
+    return font;
+}
+
+const QFont& menuEntryFont(bool selected)
+{
+    static const QFont regular = [] {
+        QFont font;
+        font.setPointSize(22);
+        return font;
+    }();
+    static const QFont bold = [] {
+        QFont font = regular;
+        font.setBold(true);
+        return font;
+    }();
+    return selected ? bold : regular;
+}
+} // namespace
+
 MenuSystem::MenuSystem() = default;
 
 void MenuSystem::setGame(Game* game)
@@ -65,6 +95,7 @@ bool MenuSystem::handleInput(QKeyEvent& event)
                 const int direction = isUp ? -1 : 1;
                 m_selectedIndex = (m_selectedIndex + direction + m_activeEntries.size()) % m_activeEntries.size();
                 updateSelectionVisuals();
+                highlightSelection();
             }
             event.accept();
             return true;
@@ -127,13 +158,21 @@ void MenuSystem::syncWithGameState(const GameState& state)
         return;
     }
 
-    if (m_state == MenuState::GameOverMenu && !state.isGameOver() && !state.isVictory())
+    if (m_state == MenuState::GameOverMenu && !state.isGameOver() && !state.isVictory()) {
         m_state = MenuState::None;
+        m_layoutDirty = true;
+    }
 }
 
 void MenuSystem::renderMenus()
 {
-    updateMenuOverlays();
+    if (m_layoutDirty)
+        updateMenuOverlays();
+}
+
+void MenuSystem::invalidateLayout()
+{
+    m_layoutDirty = true;
 }
 
 void MenuSystem::showMainMenu()
@@ -147,13 +186,28 @@ void MenuSystem::activateMenu(MenuState state, const QString& title, QVector<Men
     m_activeEntries = std::move(entries);
     m_activeTitle = title;
     m_selectedIndex = m_activeEntries.isEmpty() ? -1 : 0;
+    m_layoutDirty = true;
     updateMenuOverlays();
+    highlightSelection();
+}
+
+void MenuSystem::highlightSelection()
+{
+    if (m_selectedIndex < 0 || m_selectedIndex >= m_activeEntries.size())
+        return;
+
+    const auto highlight = m_activeEntries[m_selectedIndex].highlight;
+    if (highlight)
+        highlight();
 }
 
 void MenuSystem::buildMainMenu()
 {
     QVector<MenuEntry> entries;
-    entries.append(MenuEntry{QStringLiteral("Start Game"), [this]() { startGame(); }});
+    entries.append(MenuEntry{QStringLiteral("Start Game"), [this]() { startGame(); }, [this]() {
+        if (m_game)
+            m_game->preloadSavedLevel();
+    }});
     entries.append(MenuEntry{QStringLiteral("Select Level"), [this]() { buildLevelSelectMenu(); }});
     entries.append(MenuEntry{QStringLiteral("Editor"), [this]() { startEditor(); }});
     entries.append(MenuEntry{QStringLiteral("About"), [this]() { buildAboutMenu(); }});
@@ -168,7 +222,10 @@ void MenuSystem::buildPauseMenu()
 {
     QVector<MenuEntry> entries;
     entries.append(MenuEntry{QStringLiteral("Resume"), [this]() { resumeGame(); }});
-    entries.append(MenuEntry{QStringLiteral("Restart Level"), [this]() { restartLevel(); }});
+    entries.append(MenuEntry{QStringLiteral("Restart Level"), [this]() { restartLevel(); }, [this]() {
+        if (m_game)
+            m_game->preloadCurrentLevel();
+    }});
     entries.append(MenuEntry{QStringLiteral("Exit to Main Menu"), [this]() { returnToMainMenu(); }});
     activateMenu(MenuState::PauseMenu, QStringLiteral("PAUSED"), std::move(entries));
 }
@@ -176,7 +233,19 @@ void MenuSystem::buildPauseMenu()
 void MenuSystem::buildGameOverMenu(bool victory)
 {
     QVector<MenuEntry> entries;
-    entries.append(MenuEntry{QStringLiteral("Restart Level"), [this]() { restartLevel(); }});
+    if (victory && m_game && m_game->hasNextLevel()) {
+        // Наступний рівень кампанії вже готується у фоні з моменту старту поточного.
+        const int nextIndex = *m_game->currentLevelIndex() + 1;
+        entries.append(MenuEntry{QStringLiteral("Next Level"), [this, nextIndex]() {
+            if (m_game)
+                m_game->setPendingLevelIndex(nextIndex);
+            restartLevel();
+        }});
+    }
+    entries.append(MenuEntry{QStringLiteral("Restart Level"), [this]() { restartLevel(); }, [this]() {
+        if (m_game)
+            m_game->preloadCurrentLevel();
+    }});
     entries.append(MenuEntry{QStringLiteral("Exit to Main Menu"), [this]() { returnToMainMenu(); }});
     const QString title = victory ? QStringLiteral("STAGE CLEAR") : QStringLiteral("GAME OVER");
     activateMenu(MenuState::GameOverMenu, title, std::move(entries));
@@ -206,15 +275,22 @@ void MenuSystem::buildLevelSelectMenu()
 {
     QVector<MenuEntry> entries;
 
+    // Список береться з кешованого індексу, тож меню не читає каталог карт.
     LevelLoader loader;
-    const QStringList levelFiles = loader.availableLevelFiles();
+    const QVector<LevelIndexEntry> levels = loader.availableLevels();
 
-    for (int i = 0; i < levelFiles.size(); ++i) {
-        const QString label = QStringLiteral("Level %1").arg(i + 1);
+    for (int i = 0; i < levels.size(); ++i) {
+        const QSize size = levels.at(i).size;
+        const QString label = !size.isEmpty()
+            ? QStringLiteral("Level %1  %2x%3").arg(i + 1).arg(size.width()).arg(size.height())
+            : QStringLiteral("Level %1").arg(i + 1);
         entries.append(MenuEntry{label, [this, i]() {
             if (m_game)
                 m_game->setPendingLevelIndex(i);
             startGame();
+        }, [this, i]() {
+            if (m_game)
+                m_game->preloadLevel(i);
         }});
     }
 
@@ -222,6 +298,12 @@ void MenuSystem::buildLevelSelectMenu()
         entries.append(MenuEntry{QStringLiteral("No levels found"), nullptr});
     }
 
+    entries.append(MenuEntry{QStringLiteral("Random Map"), [this]() {
+        if (m_game)
+            m_game->setPendingLevelSeed(QRandomGenerator::global()->generate64());
+        startGame();
+    }});
+
     entries.append(MenuEntry{QStringLiteral("Back"), [this]() { buildMainMenu(); }});
 
     activateMenu(MenuState::MainMenu, QStringLiteral("SELECT LEVEL"), std::move(entries));
@@ -270,7 +352,7 @@ void MenuSystem::restartLevel()
 {
     clearInput();
     if (m_game)
-        m_game->startNewGame();
+        m_game->restart();
     m_state = MenuState::None;
     clearGameOverOverlay();
     hideMenuItems();
@@ -373,19 +455,9 @@ void MenuSystem::updateMenuPanel(const QRectF& rect)
     const qreal panelWidth = std::min(rect.width() * 0.6, 420.0);
     const qreal padding = 24.0;
     const qreal spacing = 12.0;
-    const QFont titleFont = [] {
-        QFont font;
-        font.setPointSize(34);
-        font.setBold(true);
-        return font;
-    }();
-    const QFont entryFont = [] {
-        QFont font;
-        font.setPointSize(22);
-        return font;
-    }();
+    const QFont& titleFont = menuTitleFont();
     const QFontMetrics titleMetrics(titleFont);
-    const QFontMetrics entryMetrics(entryFont);
+    const QFontMetrics entryMetrics(menuEntryFont(false));
     const qreal titleHeight = static_cast<qreal>(titleMetrics.height());
     const qreal entryHeight = static_cast<qreal>(entryMetrics.height());
     const qreal entriesHeight = m_activeEntries.isEmpty() ? 0.0
@@ -401,12 +473,14 @@ void MenuSystem::updateMenuPanel(const QRectF& rect)
     m_menuPanel->setRect(panelRect);
     m_menuPanel->setVisible(true);
 
-    if (!m_menuTitleItem)
+    if (!m_menuTitleItem) {
         m_menuTitleItem = m_scene->addText(QString());
-    m_menuTitleItem->setDefaultTextColor(Qt::white);
-    m_menuTitleItem->setFont(titleFont);
-    m_menuTitleItem->setPlainText(m_activeTitle);
-    m_menuTitleItem->setZValue(1420);
+        m_menuTitleItem->setDefaultTextColor(Qt::white);
+        m_menuTitleItem->setFont(titleFont);
+        m_menuTitleItem->setZValue(1420);
+    }
+    if (m_menuTitleItem->toPlainText() != m_activeTitle)
+        m_menuTitleItem->setPlainText(m_activeTitle);
     const qreal titleWidth = static_cast<qreal>(titleMetrics.horizontalAdvance(m_activeTitle));
     const QPointF titlePos(panelRect.center().x() - titleWidth / 2.0,
                            panelRect.top() + padding);
@@ -435,41 +509,36 @@ void MenuSystem::updateMenuEntries(const QRectF& panelRect)
 
     const qreal padding = 24.0;
     const qreal spacing = 12.0;
-    const QFont entryFont = [] {
-        QFont font;
-        font.setPointSize(22);
-        return font;
-    }();
-    const QFont selectedFont = [] {
-        QFont font;
-        font.setPointSize(22);
-        font.setBold(true);
-        return font;
-    }();
-    const QFont titleFont = [] {
-        QFont font;
-        font.setPointSize(34);
-        font.setBold(true);
-        return font;
-    }();
-
-    const qreal titleHeight = static_cast<qreal>(QFontMetrics(titleFont).height());
+    const qreal titleHeight = static_cast<qreal>(QFontMetrics(menuTitleFont()).height());
+    const qreal entryHeight = static_cast<qreal>(QFontMetrics(menuEntryFont(false)).height());
     qreal currentY = panelRect.top() + padding + titleHeight + (m_activeEntries.isEmpty() ? 0.0 : spacing * 2.0);
 
     for (int i = 0; i < m_activeEntries.size(); ++i) {
-        const MenuEntry& entry = m_activeEntries[i];
         QGraphicsTextItem* item = m_menuEntryItems[i];
-        const bool selected = (i == m_selectedIndex);
-        const QFont& font = selected ? selectedFont : entryFont;
-        item->setFont(font);
-        item->setPlainText(entry.label);
-        item->setDefaultTextColor(selected ? QColor(255, 236, 140) : QColor(225, 225, 225));
-        const qreal textWidth = static_cast<qreal>(QFontMetrics(font).horizontalAdvance(entry.label));
-        const QPointF pos(panelRect.center().x() - textWidth / 2.0, currentY);
-        item->setPos(pos);
+        if (item->toPlainText() != m_activeEntries[i].label)
+            item->setPlainText(m_activeEntries[i].label);
+        item->setPos(item->pos().x(), currentY);
+        styleEntry(i);
         item->setVisible(true);
-        currentY += static_cast<qreal>(QFontMetrics(entryFont).height()) + spacing;
+        currentY += entryHeight + spacing;
     }
+    m_highlightedIndex = m_selectedIndex;
+}
+
+void MenuSystem::styleEntry(int index)
+{
+    if (index < 0 || index >= m_activeEntries.size() || index >= m_menuEntryItems.size() || !m_menuPanel)
+        return;
+
+    // Жирний шрифт ширший, тож пункт центрується заново; рядок лишається тим самим.
+    QGraphicsTextItem* item = m_menuEntryItems[index];
+    const bool selected = (index == m_selectedIndex);
+    const QFont& font = menuEntryFont(selected);
+    if (item->font() != font)
+        item->setFont(font);
+    item->setDefaultTextColor(selected ? QColor(255, 236, 140) : QColor(225, 225, 225));
+    const qreal textWidth = static_cast<qreal>(QFontMetrics(font).horizontalAdvance(m_activeEntries[index].label));
+    item->setPos(m_menuPanel->rect().center().x() - textWidth / 2.0, item->pos().y());
 }
 
 void MenuSystem::hideMenuItems()
@@ -486,7 +555,11 @@ void MenuSystem::hideMenuItems()
 
 void MenuSystem::updateSelectionVisuals()
 {
-    updateMenuEntries(m_menuPanel ? m_menuPanel->rect() : QRectF());
+    // Перемикання пункту не чіпає розкладку: перефарбовуються лише старий і новий пункти.
+    if (m_highlightedIndex != m_selectedIndex)
+        styleEntry(m_highlightedIndex);
+    styleEntry(m_selectedIndex);
+    m_highlightedIndex = m_selectedIndex;
 }
 
 QRectF MenuSystem::sceneRect() const
@@ -523,9 +596,11 @@ void MenuSystem::updateMenuOverlays()
     if (!m_scene)
         return;
 
+    // Без розміру сцени розкладка лишається «брудною» й повториться наступного кадру.
     const QRectF rect = sceneRect();
     if (!rect.isValid() || rect.isNull())
         return;
+    m_layoutDirty = false;
 
     updateMenuBackground(rect, blocksGameplay());
 
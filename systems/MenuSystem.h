@@ -23,6 +23,12 @@ enum class MenuState {
     About,
 };
 
+/*
+ * MenuSystem — головне меню, пауза, кінець гри й «Про гру» поверх сцени.
+ * Елементи меню утримуються сценою: розкладка будується один раз при зміні
+ * стану чи розміру вікна (invalidateLayout), а перемикання пункту лише
+ * перефарбовує два пункти. Кадри з відкритим, але незмінним меню нічого не рахують.
+ */
 class MenuSystem
 {
 public:
@@ -37,13 +43,18 @@ public:
     bool blocksGameplay() const;
     bool handleInput(QKeyEvent& event);
     void syncWithGameState(const GameState& state);
+    // Дешево щокадру: перебудовує меню лише після invalidateLayout() чи зміни стану.
     void renderMenus();
+    // Розмір вікна змінився: розкладка перебудується в наступному renderMenus().
+    void invalidateLayout();
     void showMainMenu();
 
 private:
     struct MenuEntry {
         QString label;
         std::function<void()> action;
+        // Викликається, коли пункт стає виділеним (наприклад, фонове завантаження рівня).
+        std::function<void()> highlight;
     };
 
     void activateMenu(MenuState state, const QString& title, QVector<MenuEntry> entries);
@@ -69,6 +80,8 @@ private:
     void updateMenuEntries(const QRectF& rect);
     void hideMenuItems();
     void updateSelectionVisuals();
+    void styleEntry(int index);
+    void highlightSelection();
     QRectF sceneRect() const;
     void clearGameOverOverlay();
     void updateMenuOverlays();
@@ -87,6 +100,8 @@ private:
     QVector<MenuEntry> m_activeEntries;
     QString m_activeTitle;
     int m_selectedIndex = 0;
+    int m_highlightedIndex = -1;    // пункт, намальований виділеним
+    bool m_layoutDirty = true;
     bool m_victory = false;
     std::function<void()> m_exitCallback;
 };
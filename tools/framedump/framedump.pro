@@ -0,0 +1,113 @@
+QT       += core gui concurrent
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = framedump
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../ai/AIScheduler.cpp \
+    ../../ai/CooperativePlanner.cpp \
+    ../../ai/EnemyAI.cpp \
+    ../../ai/EnemyCommander.cpp \
+    ../../ai/MovementController.cpp \
+    ../../ai/ReservationTable.cpp \
+    ../../ai/ShootingController.cpp \
+    ../../ai/SimState.cpp \
+    ../../ai/ThreatMap.cpp \
+    ../../core/Game.cpp \
+    ../../core/GameRules.cpp \
+    ../../core/SessionRecording.cpp \
+    ../../core/GameState.cpp \
+    ../../gameplay/Bonus.cpp \
+    ../../gameplay/Bullet.cpp \
+    ../../gameplay/EnemyTank.cpp \
+    ../../gameplay/GameObject.cpp \
+    ../../gameplay/HealthSystem.cpp \
+    ../../gameplay/PlayerTank.cpp \
+    ../../gameplay/Tank.cpp \
+    ../../gameplay/WeaponSystem.cpp \
+    ../../rendering/Camera.cpp \
+    ../../rendering/DrawListPainter.cpp \
+    ../../rendering/FrameExporter.cpp \
+    ../../rendering/FrameWriter.cpp \
+    ../../rendering/HudPainter.cpp \
+    ../../rendering/ImageRenderBackend.cpp \
+    ../../rendering/OffscreenRenderer.cpp \
+    ../../rendering/RenderBackend.cpp \
+    ../../rendering/RenderLayout.cpp \
+    ../../rendering/Renderer.cpp \
+    ../../rendering/SpriteManager.cpp \
+    ../../systems/CollisionSystem.cpp \
+    ../../systems/InputSystem.cpp \
+    ../../systems/PhysicsSystem.cpp \
+    ../../world/Base.cpp \
+    ../../world/BinaryLevelCodec.cpp \
+    ../../world/LevelGenerator.cpp \
+    ../../world/LevelIndex.cpp \
+    ../../world/LevelLoader.cpp \
+    ../../world/LevelParser.cpp \
+    ../../world/LevelPreloader.cpp \
+    ../../world/Map.cpp \
+    ../../world/MapChunkStore.cpp \
+    ../../world/OccupancyGrid.cpp \
+    ../../world/Tile.cpp \
+    ../../world/WalkableRegions.cpp \
+    ../../world/Wall.cpp
+
+HEADERS += \
+    ../../ai/AIContext.h \
+    ../../ai/AIScheduler.h \
+    ../../ai/CooperativePlanner.h \
+    ../../ai/EnemyAI.h \
+    ../../ai/EnemyCommander.h \
+    ../../ai/MovementController.h \
+    ../../ai/ReservationTable.h \
+    ../../ai/ShootingController.h \
+    ../../ai/SimState.h \
+    ../../ai/ThreatMap.h \
+    ../../core/Game.h \
+    ../../core/GameRules.h \
+    ../../core/SessionRecording.h \
+    ../../core/GameState.h \
+    ../../enums/enums.h \
+    ../../gameplay/Bonus.h \
+    ../../gameplay/Bullet.h \
+    ../../gameplay/Direction.h \
+    ../../gameplay/EnemyTank.h \
+    ../../gameplay/GameObject.h \
+    ../../gameplay/HealthSystem.h \
+    ../../gameplay/PlayerTank.h \
+    ../../gameplay/Tank.h \
+    ../../gameplay/WeaponSystem.h \
+    ../../rendering/Camera.h \
+    ../../rendering/DrawListPainter.h \
+    ../../rendering/FrameExporter.h \
+    ../../rendering/FrameWriter.h \
+    ../../rendering/HudPainter.h \
+    ../../rendering/ImageRenderBackend.h \
+    ../../rendering/OffscreenRenderer.h \
+    ../../rendering/RenderBackend.h \
+    ../../rendering/RenderLayout.h \
+    ../../rendering/Renderer.h \
+    ../../rendering/SpriteManager.h \
+    ../../systems/CollisionSystem.h \
+    ../../systems/InputSystem.h \
+    ../../systems/PhysicsSystem.h \
+    ../../utils/Constants.h \
+    ../../world/Base.h \
+    ../../world/BinaryLevelCodec.h \
+    ../../world/LevelGenerator.h \
+    ../../world/LevelIndex.h \
+    ../../world/LevelLoader.h \
+    ../../world/LevelParser.h \
+    ../../world/LevelPreloader.h \
+    ../../world/Map.h \
+    ../../world/MapChunkStore.h \
+    ../../world/OccupancyGrid.h \
+    ../../world/Tile.h \
+    ../../world/WalkableRegions.h \
+    ../../world/Wall.h
@@ -0,0 +1,240 @@
+#include <QCommandLineParser>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QImage>
+#include <QSize>
+#include <QTextStream>
+#include <QThreadPool>
+#include <numeric>
+
+#include "core/Game.h"
+#include "core/SessionRecording.h"
+#include "rendering/FrameExporter.h"
+#include "rendering/FrameWriter.h"
+#include "rendering/OffscreenRenderer.h"
+#include "rendering/SpriteManager.h"
+#include "systems/InputSystem.h"
+#include "utils/Constants.h"
+
+/*
+ * framedump — проганяє гру без вікна й дисплея та зберігає кадри: кожен тік
+ * або кожен N-й, у PNG, «сирому» RGB32 чи одним потоком Y4M. З --replay повторює
+ * партію, записану грою з --record, тік у тік із тим самим вводом.
+ * Кадри малюються в головному потоці, а кодуються паралельно через FrameExporter.
+ * З --hash друкує SHA-1 кожного кадру, щоби тести порівнювали картинку
+ * з еталоном без збереження файлів. Симуляція завжди детермінована: без запису
+ * зерно сесії задає --session-seed. Спрайти завантажуються до першого кадру, тож
+ * хеш не залежить від того, як швидко декодувались аркуші. Без явної платформи Qt запускається на offscreen.
+ */
+namespace {
+constexpr int kTickMs = 16;     // той самий фіксований крок, що й у MainWindow
+constexpr quint64 kDefaultSessionSeed = 1;
+
+QByteArray frameHash(const QImage& image)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const qsizetype rowBytes = static_cast<qsizetype>(image.width()) * 4;
+    for (int y = 0; y < image.height(); ++y)
+        hash.addData(QByteArrayView(reinterpret_cast<const char*>(image.constScanLine(y)), rowBytes));
+    return hash.result().toHex();
+}
+
+bool parseSize(const QString& text, QSize* size)
+{
+    const QStringList parts = text.split(QLatin1Char('x'));
+    if (parts.size() != 2)
+        return false;
+    bool okWidth = false;
+    bool okHeight = false;
+    const int width = parts.at(0).toInt(&okWidth);
+    const int height = parts.at(1).toInt(&okHeight);
+    if (!okWidth || !okHeight || width <= 0 || height <= 0)
+        return false;
+    *size = QSize(width, height);
+    return true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+    QGuiApplication::setApplicationName(QStringLiteral("framedump"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Simulate a level without a window and dump rendered frames."));
+    parser.addHelpOption();
+    const QCommandLineOption levelOption(QStringList() << QStringLiteral("l") << QStringLiteral("level"),
+                                         QStringLiteral("Level index to play."), QStringLiteral("index"),
+                                         QStringLiteral("0"));
+    const QCommandLineOption seedOption(QStringList() << QStringLiteral("seed"),
+                                        QStringLiteral("Play a generated level with this seed instead."),
+                                        QStringLiteral("seed"));
+    const QCommandLineOption ticksOption(QStringList() << QStringLiteral("t") << QStringLiteral("ticks"),
+                                         QStringLiteral("Number of simulation ticks."), QStringLiteral("count"),
+                                         QStringLiteral("600"));
+    const QCommandLineOption everyOption(QStringList() << QStringLiteral("e") << QStringLiteral("every"),
+                                         QStringLiteral("Keep every Nth frame."), QStringLiteral("n"),
+                                         QStringLiteral("1"));
+    const QCommandLineOption sizeOption(QStringList() << QStringLiteral("s") << QStringLiteral("size"),
+                                        QStringLiteral("Frame size in pixels."), QStringLiteral("WxH"),
+                                        QStringLiteral("800x600"));
+    const QCommandLineOption formatOption(QStringList() << QStringLiteral("f") << QStringLiteral("format"),
+                                          QStringLiteral("png, raw (RGB32 rows), y4m (one YUV 4:2:0 stream) or none."),
+                                          QStringLiteral("format"), QStringLiteral("png"));
+    const QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"),
+                                          QStringLiteral("Directory for frame files, or the stream file for y4m."),
+                                          QStringLiteral("path"));
+    const QCommandLineOption hashOption(QStringList() << QStringLiteral("hash"),
+                                        QStringLiteral("Print the SHA-1 of every kept frame."));
+    const QCommandLineOption replayOption(QStringList() << QStringLiteral("r") << QStringLiteral("replay"),
+                                          QStringLiteral("Re-simulate a session recorded with --record."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption sessionSeedOption(QStringList() << QStringLiteral("session-seed"),
+                                               QStringLiteral("Random seed of the simulated session (ignored with --replay)."),
+                                               QStringLiteral("seed"), QString::number(kDefaultSessionSeed));
+    const QCommandLineOption threadsOption(QStringList() << QStringLiteral("j") << QStringLiteral("threads"),
+                                           QStringLiteral("Encoder threads (default: all cores)."), QStringLiteral("n"));
+    const QCommandLineOption spritesOption(QStringList() << QStringLiteral("sprites"),
+                                           QStringLiteral("Sprite manifest (default: assets/sprites/sprites.json)."),
+                                           QStringLiteral("file"));
+    const QCommandLineOption noSpritesOption(QStringList() << QStringLiteral("no-sprites"),
+                                             QStringLiteral("Draw procedural textures only."));
+    parser.addOptions({levelOption, seedOption, ticksOption, everyOption, sizeOption, formatOption, outputOption, hashOption,
+                       replayOption, sessionSeedOption, threadsOption, spritesOption, noSpritesOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QSize frameSize;
+    if (!parseSize(parser.value(sizeOption), &frameSize)) {
+        err << "Invalid frame size: " << parser.value(sizeOption) << Qt::endl;
+        return 1;
+    }
+    const int every = qMax(1, parser.value(everyOption).toInt());
+
+    SessionRecording recording;
+    const bool replay = parser.isSet(replayOption);
+    if (replay) {
+        QString error;
+        if (!recording.load(parser.value(replayOption), &error)) {
+            err << parser.value(replayOption) << ": " << error << Qt::endl;
+            return 1;
+        }
+    }
+    const int tickMs = replay && recording.tickMs() > 0 ? recording.tickMs() : kTickMs;
+    // Повтор за замовчуванням іде до кінця запису; --ticks може лише вкоротити його.
+    int ticks = qMax(0, parser.value(ticksOption).toInt());
+    if (replay) {
+        const int recordedTicks = static_cast<int>(recording.tickCount());
+        ticks = parser.isSet(ticksOption) ? qMin(ticks, recordedTicks) : recordedTicks;
+    }
+
+    const QString formatName = parser.value(formatOption);
+    const bool writeFiles = formatName != QLatin1String("none");
+    FrameWriter::Format format = FrameWriter::Format::Png;
+    if (formatName == QLatin1String("raw")) {
+        format = FrameWriter::Format::Raw;
+    } else if (formatName == QLatin1String("y4m")) {
+        format = FrameWriter::Format::Y4m;
+    } else if (writeFiles && formatName != QLatin1String("png")) {
+        err << "Unknown format: " << formatName << Qt::endl;
+        return 1;
+    }
+
+    if (parser.isSet(threadsOption))
+        QThreadPool::globalInstance()->setMaxThreadCount(qMax(1, parser.value(threadsOption).toInt()));
+
+    // Частота потоку — збережені кадри за секунду симуляції, нескоротним дробом.
+    const int frameIntervalMs = tickMs * every;
+    const int fpsDivisor = std::gcd(1000, frameIntervalMs);
+    FrameExporter::Options exportOptions;
+    exportOptions.format = format;
+    exportOptions.frameSize = frameSize;
+    exportOptions.fpsNumerator = 1000 / fpsDivisor;
+    exportOptions.fpsDenominator = frameIntervalMs / fpsDivisor;
+    exportOptions.outputPath = parser.isSet(outputOption)
+        ? parser.value(outputOption)
+        : (format == FrameWriter::Format::Y4m ? QStringLiteral("frames.y4m") : QStringLiteral("frames"));
+
+    FrameExporter exporter;
+    if (writeFiles && !exporter.open(exportOptions)) {
+        err << exportOptions.outputPath << ": " << exporter.errorString() << Qt::endl;
+        return 1;
+    }
+
+    Game game;
+    InputSystem input;
+    game.setInputSystem(&input);
+    GameRules& rules = game.rules();
+    rules.setMapSize(QSize(GRID_WIDTH, GRID_HEIGHT));
+    rules.setBaseCell(QPoint(GRID_WIDTH / 2, GRID_HEIGHT - 2));
+    rules.setDeterministic(true);
+    if (replay) {
+        recording.applyTo(rules);
+        if (recording.levelSeed().has_value())
+            game.setPendingLevelSeed(*recording.levelSeed());
+        else if (recording.levelIndex().has_value())
+            game.setPendingLevelIndex(*recording.levelIndex());
+        else
+            err << "Recording played the saved level; replaying the current saved level" << Qt::endl;
+        game.setPendingSessionSeed(recording.sessionSeed());
+    } else {
+        if (parser.isSet(seedOption))
+            game.setPendingLevelSeed(parser.value(seedOption).toULongLong());
+        else
+            game.setPendingLevelIndex(parser.value(levelOption).toInt());
+        game.setPendingSessionSeed(parser.value(sessionSeedOption).toULongLong());
+    }
+    game.startNewGame();
+
+    SpriteManager sprites;      // переживає renderer, що тримає на нього вказівник
+    OffscreenRenderer renderer(frameSize);
+    if (!parser.isSet(noSpritesOption)) {
+        const QString manifest = parser.isSet(spritesOption) ? parser.value(spritesOption) : SpriteManager::defaultManifestPath();
+        QString error;
+        if (!sprites.loadManifest(manifest, &error))
+            err << manifest << ": " << error << Qt::endl;
+        sprites.loadAsync();
+        sprites.waitForLoaded();
+        renderer.setSpriteManager(&sprites);
+    }
+    QElapsedTimer timer;
+    timer.start();
+    int keptFrames = 0;
+
+    for (int tick = 0; tick < ticks; ++tick) {
+        if (replay)
+            input.restore(recording.input(tick));
+        game.update(tickMs);
+        const bool keep = tick % every == 0;
+        renderer.renderFrame(game, keep);
+        if (!keep)
+            continue;
+
+        ++keptFrames;
+        if (parser.isSet(hashOption))
+            out << tick << ' ' << frameHash(renderer.image()) << Qt::endl;
+        if (writeFiles && !exporter.addFrame(renderer.image(), tick)) {
+            err << exporter.errorString() << Qt::endl;
+            return 2;
+        }
+    }
+
+    if (writeFiles && !exporter.finish()) {
+        err << exporter.errorString() << Qt::endl;
+        return 2;
+    }
+
+    const qint64 elapsedMs = qMax<qint64>(1, timer.elapsed());
+    err << keptFrames << " frames of " << ticks << " ticks in " << elapsedMs << " ms ("
+        << (keptFrames * 1000 / elapsedMs) << " frames/s)";
+    if (writeFiles)
+        err << ", " << exporter.bytesWritten() / 1024 << " KiB written";
+    err << Qt::endl;
+    return 0;
+}
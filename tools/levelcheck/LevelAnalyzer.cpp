@@ -0,0 +1,315 @@
+#include "LevelAnalyzer.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QPoint>
+#include <QVector>
+#include <memory>
+
+#include "core/GameRules.h"
+#include "world/LevelLoader.h"
+#include "world/Map.h"
+#include "world/Tile.h"
+
+namespace {
+constexpr int kMaxReportedChokepoints = 32;
+constexpr QPoint kDirections[4] = {QPoint(1, 0), QPoint(-1, 0), QPoint(0, 1), QPoint(0, -1)};
+
+QJsonArray cellToJson(const QPoint& cell)
+{
+    return QJsonArray{cell.x(), cell.y()};
+}
+
+QString tileTypeName(TileType type)
+{
+    switch (type) {
+    case TileType::Empty: return QStringLiteral("empty");
+    case TileType::Brick: return QStringLiteral("brick");
+    case TileType::Steel: return QStringLiteral("steel");
+    case TileType::Base: return QStringLiteral("base");
+    case TileType::Forest: return QStringLiteral("forest");
+    case TileType::Water: return QStringLiteral("water");
+    case TileType::Ice: return QStringLiteral("ice");
+    }
+    return QStringLiteral("unknown");
+}
+
+// Плоска копія карти: прохідність за BlockTank і руйнівність, без повторних викликів Map::tile.
+class Grid
+{
+public:
+    explicit Grid(const Map& map)
+        : m_width(map.size().width()), m_height(map.size().height())
+    {
+        const qsizetype count = static_cast<qsizetype>(m_width) * m_height;
+        m_walkable.resize(count);
+        m_breakable.resize(count);
+        for (int y = 0; y < m_height; ++y) {
+            for (int x = 0; x < m_width; ++x) {
+                const QPoint cell(x, y);
+                const Tile tile = map.tile(cell);
+                const qsizetype i = index(cell);
+                m_walkable[i] = map.isWalkable(cell);
+                m_breakable[i] = tile.destructible && tile.type != TileType::Base;
+            }
+        }
+    }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    qsizetype count() const { return m_walkable.size(); }
+    bool isInside(const QPoint& cell) const
+    {
+        return cell.x() >= 0 && cell.y() >= 0 && cell.x() < m_width && cell.y() < m_height;
+    }
+    qsizetype index(const QPoint& cell) const { return static_cast<qsizetype>(cell.y()) * m_width + cell.x(); }
+    QPoint cellAt(qsizetype i) const { return QPoint(static_cast<int>(i % m_width), static_cast<int>(i / m_width)); }
+    bool isWalkable(qsizetype i) const { return m_walkable.at(i); }
+    bool isPassableThroughBricks(qsizetype i) const { return m_walkable.at(i) || m_breakable.at(i); }
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    QVector<quint8> m_walkable;
+    QVector<quint8> m_breakable;
+};
+
+// BFS від клітинок, сусідніх із базою; відстань до бази = відстань до такої клітинки + 1.
+template <typename Passable>
+QVector<int> distancesToBase(const Grid& grid, const QPoint& base, Passable&& passable)
+{
+    QVector<int> distance(grid.count(), -1);
+    QVector<qsizetype> queue;
+    queue.reserve(grid.count());
+    for (const QPoint& direction : kDirections) {
+        const QPoint cell = base + direction;
+        if (!grid.isInside(cell))
+            continue;
+        const qsizetype i = grid.index(cell);
+        if (!passable(i) || distance.at(i) >= 0)
+            continue;
+        distance[i] = 1;
+        queue.append(i);
+    }
+
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const qsizetype current = queue.at(head);
+        const QPoint cell = grid.cellAt(current);
+        for (const QPoint& direction : kDirections) {
+            const QPoint next = cell + direction;
+            if (!grid.isInside(next))
+                continue;
+            const qsizetype i = grid.index(next);
+            if (distance.at(i) >= 0 || !passable(i))
+                continue;
+            distance[i] = distance.at(current) + 1;
+            queue.append(i);
+        }
+    }
+    return distance;
+}
+
+// Точки зчленування графа прохідних клітинок у частині карти, звідки можна дістатися бази:
+// закриття будь-якої з них (танком, новою стіною) відрізає частину карти.
+// Ітеративний алгоритм Тарʼяна без рекурсії, щоби великі карти не переповнювали стек.
+QVector<QPoint> findChokepoints(const Grid& grid, const QVector<int>& distance)
+{
+    const qsizetype count = grid.count();
+    QVector<int> discovery(count, -1);
+    QVector<int> low(count, 0);
+    QVector<qsizetype> parent(count, -1);
+    QVector<quint8> nextDirection(count, 0);
+    QVector<quint8> articulation(count, 0);
+    QVector<qsizetype> stack;
+    int time = 0;
+
+    for (qsizetype root = 0; root < count; ++root) {
+        if (distance.at(root) < 0 || !grid.isWalkable(root) || discovery.at(root) >= 0)
+            continue;
+
+        int rootChildren = 0;
+        discovery[root] = low[root] = time++;
+        stack.append(root);
+        while (!stack.isEmpty()) {
+            const qsizetype current = stack.last();
+            if (nextDirection.at(current) < 4) {
+                const QPoint next = grid.cellAt(current) + kDirections[nextDirection.at(current)];
+                ++nextDirection[current];
+                if (!grid.isInside(next))
+                    continue;
+                const qsizetype i = grid.index(next);
+                if (!grid.isWalkable(i))
+                    continue;
+                if (discovery.at(i) < 0) {
+                    parent[i] = current;
+                    discovery[i] = low[i] = time++;
+                    stack.append(i);
+                    if (current == root)
+                        ++rootChildren;
+                } else if (i != parent.at(current)) {
+                    low[current] = qMin(low.at(current), discovery.at(i));
+                }
+                continue;
+            }
+
+            stack.removeLast();
+            const qsizetype up = parent.at(current);
+            if (up < 0)
+                continue;
+            low[up] = qMin(low.at(up), low.at(current));
+            if (up != root && low.at(current) >= discovery.at(up))
+                articulation[up] = 1;
+        }
+        if (rootChildren > 1)
+            articulation[root] = 1;
+    }
+
+    QVector<QPoint> chokepoints;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (articulation.at(i))
+            chokepoints.append(grid.cellAt(i));
+    }
+    return chokepoints;
+}
+
+// Запис у клон не має змінити оригінал — ні в пам'яті, ні через спільний файл потокової карти.
+// Порожній рядок — перевірку пройдено.
+QString checkCloneIsolation(const Map& map)
+{
+    const QPoint cell(0, 0);
+    const TileType original = map.tile(cell).type;
+    const TileType replacement = original == TileType::Brick ? TileType::Empty : TileType::Brick;
+
+    std::unique_ptr<Map> clone = map.clone();
+    clone->setTile(cell, TileFactory::forType(replacement));
+    if (map.isStreamed()) {
+        // Клон вивантажує все, крім зміненого чанка, який без права запису лишається в пам'яті.
+        clone->setResidentChunkBudget(1);
+        clone->retainAreas({});
+    }
+
+    if (map.tile(cell).type != original)
+        return QStringLiteral("a write to a map clone changed the original");
+    if (clone->tile(cell).type != replacement)
+        return QStringLiteral("a map clone lost its own write");
+    return QString();
+}
+} // namespace
+
+QJsonObject LevelAnalyzer::analyze(const QString& filePath)
+{
+    QJsonObject report;
+    report.insert(QStringLiteral("file"), QFileInfo(filePath).fileName());
+
+    QJsonArray errors;
+    QJsonArray warnings;
+    const auto finish = [&]() {
+        report.insert(QStringLiteral("errors"), errors);
+        report.insert(QStringLiteral("warnings"), warnings);
+        report.insert(QStringLiteral("ok"), errors.isEmpty());
+        return report;
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    QString loadError;
+    const LevelData level = LevelLoader().loadLevelFile(filePath, GameRules(), &loadError);
+    report.insert(QStringLiteral("loadMs"), static_cast<double>(timer.nsecsElapsed()) / 1.0e6);
+    if (!level.map) {
+        errors.append(loadError.isEmpty() ? QStringLiteral("level could not be loaded") : loadError);
+        return finish();
+    }
+
+    const Map& map = *level.map;
+    const Grid grid(map);
+    report.insert(QStringLiteral("size"), QJsonArray{grid.width(), grid.height()});
+
+    QVector<int> histogram(static_cast<qsizetype>(TileType::Ice) + 1, 0);
+    for (int y = 0; y < grid.height(); ++y) {
+        for (int x = 0; x < grid.width(); ++x)
+            ++histogram[static_cast<int>(map.tile(QPoint(x, y)).type)];
+    }
+    QJsonObject histogramJson;
+    for (int type = 0; type < histogram.size(); ++type)
+        histogramJson.insert(tileTypeName(static_cast<TileType>(type)), histogram.at(type));
+    report.insert(QStringLiteral("histogram"), histogramJson);
+
+    report.insert(QStringLiteral("base"), cellToJson(level.baseCell));
+    if (!map.isInside(level.baseCell) || map.tile(level.baseCell).type != TileType::Base) {
+        errors.append(QStringLiteral("base tile missing at (%1, %2)").arg(level.baseCell.x()).arg(level.baseCell.y()));
+        return finish();
+    }
+    if (histogram.at(static_cast<int>(TileType::Base)) > 1)
+        warnings.append(QStringLiteral("more than one base tile"));
+
+    const QVector<int> distance = distancesToBase(grid, level.baseCell, [&grid](qsizetype i) { return grid.isWalkable(i); });
+    const QVector<int> distanceThroughBricks = distancesToBase(grid, level.baseCell, [&grid](qsizetype i) {
+        return grid.isPassableThroughBricks(i);
+    });
+
+    struct SpawnCheck
+    {
+        QString kind;
+        QPoint cell;
+    };
+    QVector<SpawnCheck> spawns;
+    spawns.append(SpawnCheck{QStringLiteral("player"), level.playerSpawn});
+    for (const QPoint& spawn : level.enemySpawns)
+        spawns.append(SpawnCheck{QStringLiteral("enemy"), spawn});
+    if (level.enemySpawns.isEmpty())
+        errors.append(QStringLiteral("no enemy spawns"));
+
+    QJsonArray spawnsJson;
+    int shortestDistance = -1;
+    for (const auto& [kind, cell] : spawns) {
+        QJsonObject spawnJson;
+        spawnJson.insert(QStringLiteral("kind"), kind);
+        spawnJson.insert(QStringLiteral("cell"), cellToJson(cell));
+
+        const bool inside = grid.isInside(cell);
+        const qsizetype i = inside ? grid.index(cell) : -1;
+        const bool walkable = inside && grid.isWalkable(i);
+        const int steps = inside ? distance.at(i) : -1;
+        const int stepsThroughBricks = inside ? distanceThroughBricks.at(i) : -1;
+        spawnJson.insert(QStringLiteral("walkable"), walkable);
+        spawnJson.insert(QStringLiteral("reachable"), steps >= 0);
+        spawnJson.insert(QStringLiteral("reachableThroughBricks"), stepsThroughBricks >= 0);
+        spawnJson.insert(QStringLiteral("distance"), steps);
+        spawnJson.insert(QStringLiteral("distanceThroughBricks"), stepsThroughBricks);
+        spawnsJson.append(spawnJson);
+
+        const QString where = QStringLiteral("%1 spawn (%2, %3)").arg(kind).arg(cell.x()).arg(cell.y());
+        if (!walkable) {
+            errors.append(where + QStringLiteral(" is not walkable"));
+            continue;
+        }
+        // Цеглу навколо бази танки прострілюють, тож блокування лише цеглою — попередження.
+        if (stepsThroughBricks < 0)
+            errors.append(where + QStringLiteral(" cannot reach the base"));
+        else if (steps < 0)
+            warnings.append(where + QStringLiteral(" reaches the base only through bricks"));
+
+        const int best = steps >= 0 ? steps : stepsThroughBricks;
+        if (kind == QLatin1String("enemy") && best >= 0 && (shortestDistance < 0 || best < shortestDistance))
+            shortestDistance = best;
+    }
+    report.insert(QStringLiteral("spawns"), spawnsJson);
+    report.insert(QStringLiteral("shortestSpawnDistance"), shortestDistance);
+
+    const QVector<QPoint> chokepoints = findChokepoints(grid, distanceThroughBricks);
+    QJsonArray chokepointCells;
+    for (qsizetype i = 0; i < chokepoints.size() && i < kMaxReportedChokepoints; ++i)
+        chokepointCells.append(cellToJson(chokepoints.at(i)));
+    report.insert(QStringLiteral("chokepoints"), QJsonObject{
+        {QStringLiteral("count"), static_cast<int>(chokepoints.size())},
+        {QStringLiteral("cells"), chokepointCells},
+    });
+
+    const QString cloneError = checkCloneIsolation(map);
+    report.insert(QStringLiteral("cloneIsolated"), cloneError.isEmpty());
+    if (!cloneError.isEmpty())
+        errors.append(cloneError);
+
+    return finish();
+}
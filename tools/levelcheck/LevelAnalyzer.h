@@ -0,0 +1,20 @@
+#ifndef LEVELANALYZER_H
+#define LEVELANALYZER_H
+
+#include <QJsonObject>
+#include <QString>
+
+/*
+ * LevelAnalyzer завантажує один рівень через LevelLoader і перевіряє його так,
+ * як його бачить гра: база на місці, спавни прохідні за маскою BlockTank, кожен
+ * спавн досяжний до бази. Окремо рахує гістограму тайлів, вузькі місця (точки
+ * зчленування прохідного графа) та найкоротшу відстань від спавнів до бази.
+ * Наостанок перевіряє, що запис у Map::clone() не змінює завантажену карту,
+ * зокрема потокову.
+ * Функція чиста й не має спільного стану, тож викликається паралельно.
+ */
+namespace LevelAnalyzer {
+QJsonObject analyze(const QString& filePath);
+}
+
+#endif // LEVELANALYZER_H
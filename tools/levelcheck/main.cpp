@@ -0,0 +1,103 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QtConcurrent>
+
+#include "LevelAnalyzer.h"
+#include "world/BinaryLevelCodec.h"
+
+/*
+ * levelcheck — паралельна перевірка набору рівнів. Кожен файл аналізується
+ * в пулі потоків QtConcurrent, результат — JSON-звіт у stdout або у файл.
+ * Код виходу 0, якщо всі рівні пройшли перевірку, 2 — якщо хоч один ні.
+ */
+namespace {
+QStringList collectLevelFiles(const QStringList& inputs)
+{
+    const QStringList patterns = {
+        QStringLiteral("*.txt"),
+        QStringLiteral("*.%1").arg(BinaryLevelCodec::fileSuffix()),
+    };
+
+    QStringList files;
+    for (const QString& input : inputs) {
+        const QFileInfo info(input);
+        if (!info.isDir()) {
+            files.append(info.absoluteFilePath());
+            continue;
+        }
+
+        const QDir dir(info.absoluteFilePath());
+        for (const QString& entry : dir.entryList(patterns, QDir::Files, QDir::Name))
+            files.append(dir.absoluteFilePath(entry));
+    }
+    return files;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("levelcheck"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Validate level files and report their statistics as JSON."));
+    parser.addHelpOption();
+    const QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"),
+                                          QStringLiteral("Write the report to <file> instead of stdout."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption compactOption(QStringList() << QStringLiteral("c") << QStringLiteral("compact"),
+                                           QStringLiteral("Emit compact JSON."));
+    parser.addOption(outputOption);
+    parser.addOption(compactOption);
+    parser.addPositionalArgument(QStringLiteral("paths"), QStringLiteral("Level files or directories with levels."),
+                                 QStringLiteral("<path...>"));
+    parser.process(app);
+
+    const QStringList inputs = parser.positionalArguments();
+    if (inputs.isEmpty())
+        parser.showHelp(1);
+
+    const QStringList files = collectLevelFiles(inputs);
+    const QList<QJsonObject> reports = QtConcurrent::blockingMapped(files, &LevelAnalyzer::analyze);
+
+    QJsonArray levels;
+    int failed = 0;
+    for (const QJsonObject& report : reports) {
+        if (!report.value(QStringLiteral("ok")).toBool())
+            ++failed;
+        levels.append(report);
+    }
+
+    QJsonObject summary;
+    summary.insert(QStringLiteral("total"), static_cast<int>(reports.size()));
+    summary.insert(QStringLiteral("passed"), static_cast<int>(reports.size()) - failed);
+    summary.insert(QStringLiteral("failed"), failed);
+
+    QJsonObject root;
+    root.insert(QStringLiteral("summary"), summary);
+    root.insert(QStringLiteral("levels"), levels);
+
+    const QJsonDocument::JsonFormat format = parser.isSet(compactOption) ? QJsonDocument::Compact : QJsonDocument::Indented;
+    const QByteArray json = QJsonDocument(root).toJson(format);
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+            QTextStream(stderr) << file.fileName() << ": " << file.errorString() << Qt::endl;
+            return 1;
+        }
+    } else {
+        QFile output;
+        output.open(stdout, QIODevice::WriteOnly);
+        output.write(json);
+    }
+
+    return failed == 0 ? 0 : 2;
+}
@@ -0,0 +1,36 @@
+QT       += core
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = levelconv
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../core/GameRules.cpp \
+    ../../world/BinaryLevelCodec.cpp \
+    ../../world/LevelGenerator.cpp \
+    ../../world/LevelIndex.cpp \
+    ../../world/LevelLoader.cpp \
+    ../../world/LevelParser.cpp \
+    ../../world/Map.cpp \
+    ../../world/MapChunkStore.cpp \
+    ../../world/Tile.cpp \
+    ../../world/WalkableRegions.cpp \
+    ../../world/Wall.cpp
+
+HEADERS += \
+    ../../core/GameRules.h \
+    ../../world/BinaryLevelCodec.h \
+    ../../world/LevelGenerator.h \
+    ../../world/LevelIndex.h \
+    ../../world/LevelLoader.h \
+    ../../world/LevelParser.h \
+    ../../world/Map.h \
+    ../../world/MapChunkStore.h \
+    ../../world/Tile.h \
+    ../../world/WalkableRegions.h \
+    ../../world/Wall.h
@@ -0,0 +1,54 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include "core/GameRules.h"
+#include "world/BinaryLevelCodec.h"
+#include "world/LevelLoader.h"
+
+/*
+ * levelconv — конвертує текстові рівні (assets/maps/*.txt) у двійковий формат *.gslv.
+ * Результат кладеться поруч із вихідним файлом; LevelLoader сам віддає перевагу .gslv.
+ */
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("levelconv"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Convert text levels to the binary .gslv format."));
+    parser.addHelpOption();
+    const QCommandLineOption rleOption(QStringList() << QStringLiteral("r") << QStringLiteral("rle"),
+                                       QStringLiteral("Compress tiles with run-length encoding."));
+    parser.addOption(rleOption);
+    parser.addPositionalArgument(QStringLiteral("levels"), QStringLiteral("Text level files to convert."),
+                                 QStringLiteral("<level.txt...>"));
+    parser.process(app);
+
+    const QStringList inputs = parser.positionalArguments();
+    if (inputs.isEmpty())
+        parser.showHelp(1);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    const LevelLoader loader;
+    const GameRules rules;
+    int failures = 0;
+
+    for (const QString& input : inputs) {
+        const QFileInfo info(input);
+        const QString target = info.dir().filePath(info.completeBaseName() + QLatin1Char('.') + BinaryLevelCodec::fileSuffix());
+
+        QString error;
+        if (!loader.convertToBinary(info.absoluteFilePath(), target, rules, parser.isSet(rleOption), &error)) {
+            err << input << ": " << error << Qt::endl;
+            ++failures;
+            continue;
+        }
+        out << input << " -> " << target << Qt::endl;
+    }
+
+    return failures == 0 ? 0 : 2;
+}
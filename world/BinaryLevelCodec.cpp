@@ -0,0 +1,227 @@
+#include "world/BinaryLevelCodec.h"
+
+#include <QRect>
+#include <QtEndian>
+#include <cstring>
+#include <memory>
+
+#include "world/LevelLoader.h"
+#include "world/Map.h"
+
+namespace {
+constexpr char kMagic[4] = {'G', 'S', 'L', 'V'};
+constexpr int kMaxRunLength = 255;
+
+// Зсуви полів заголовка.
+constexpr int kVersionOffset = 4;
+constexpr int kFlagsOffset = 6;
+constexpr int kWidthOffset = 8;
+constexpr int kHeightOffset = 10;
+constexpr int kBaseOffset = 12;
+constexpr int kPlayerOffset = 16;
+constexpr int kSpawnCountOffset = 20;
+constexpr int kPayloadSizeOffset = 24;
+constexpr int kChecksumOffset = 28;
+
+quint32 fnv1a(const char* data, qsizetype size)
+{
+    quint32 hash = 2166136261u;
+    for (qsizetype i = 0; i < size; ++i) {
+        hash ^= static_cast<quint8>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+T readValue(const char* data, int offset)
+{
+    return qFromLittleEndian<T>(data + offset);
+}
+
+template <typename T>
+void writeValue(QByteArray& buffer, int offset, T value)
+{
+    qToLittleEndian<T>(value, buffer.data() + offset);
+}
+
+void appendPoint(QByteArray& buffer, const QPoint& point)
+{
+    char bytes[4];
+    qToLittleEndian<qint16>(static_cast<qint16>(point.x()), bytes);
+    qToLittleEndian<qint16>(static_cast<qint16>(point.y()), bytes + 2);
+    buffer.append(bytes, 4);
+}
+
+QPoint readPoint(const char* data)
+{
+    return QPoint(qFromLittleEndian<qint16>(data), qFromLittleEndian<qint16>(data + 2));
+}
+
+bool fail(QString* error, const QString& message)
+{
+    if (error)
+        *error = message;
+    return false;
+}
+} // namespace
+
+bool BinaryLevelCodec::isBinaryLevel(QByteArrayView data)
+{
+    return data.size() >= kHeaderSize && memcmp(data.data(), kMagic, sizeof(kMagic)) == 0;
+}
+
+QByteArray BinaryLevelCodec::encode(const LevelData& level, bool compress)
+{
+    QByteArray buffer;
+    if (!level.map)
+        return buffer;
+
+    const Map& map = *level.map;
+    const QSize size = map.size();
+
+    QByteArray types;
+    types.reserve(static_cast<qsizetype>(size.width()) * size.height());
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x)
+            types.append(static_cast<char>(map.tile(QPoint(x, y)).type));
+    }
+
+    QByteArray payload;
+    if (compress) {
+        payload.reserve(types.size() / 4);
+        for (qsizetype i = 0; i < types.size();) {
+            const char value = types.at(i);
+            int run = 1;
+            while (i + run < types.size() && run < kMaxRunLength && types.at(i + run) == value)
+                ++run;
+            payload.append(static_cast<char>(run));
+            payload.append(value);
+            i += run;
+        }
+    } else {
+        payload = types;
+    }
+
+    buffer.resize(kHeaderSize);
+    buffer.fill('\0');
+    memcpy(buffer.data(), kMagic, sizeof(kMagic));
+    writeValue<quint16>(buffer, kVersionOffset, kVersion);
+    writeValue<quint16>(buffer, kFlagsOffset, compress ? RunLengthEncoded : NoFlags);
+    writeValue<quint16>(buffer, kWidthOffset, static_cast<quint16>(size.width()));
+    writeValue<quint16>(buffer, kHeightOffset, static_cast<quint16>(size.height()));
+    writeValue<qint16>(buffer, kBaseOffset, static_cast<qint16>(level.baseCell.x()));
+    writeValue<qint16>(buffer, kBaseOffset + 2, static_cast<qint16>(level.baseCell.y()));
+    writeValue<qint16>(buffer, kPlayerOffset, static_cast<qint16>(level.playerSpawn.x()));
+    writeValue<qint16>(buffer, kPlayerOffset + 2, static_cast<qint16>(level.playerSpawn.y()));
+    writeValue<quint16>(buffer, kSpawnCountOffset, static_cast<quint16>(level.enemySpawns.size()));
+    writeValue<quint32>(buffer, kPayloadSizeOffset, static_cast<quint32>(payload.size()));
+
+    for (const QPoint& spawn : level.enemySpawns)
+        appendPoint(buffer, spawn);
+    buffer.append(payload);
+
+    const quint32 checksum = fnv1a(buffer.constData() + kHeaderSize, buffer.size() - kHeaderSize);
+    writeValue<quint32>(buffer, kChecksumOffset, checksum);
+    return buffer;
+}
+
+bool BinaryLevelCodec::readHeader(QByteArrayView data, BinaryLevelHeader& header, QString* error)
+{
+    if (!isBinaryLevel(data))
+        return fail(error, QStringLiteral("not a binary level"));
+
+    const char* bytes = data.data();
+    const quint16 version = readValue<quint16>(bytes, kVersionOffset);
+    if (version != kVersion)
+        return fail(error, QStringLiteral("unsupported version %1").arg(version));
+
+    const int width = readValue<quint16>(bytes, kWidthOffset);
+    const int height = readValue<quint16>(bytes, kHeightOffset);
+    const int spawnCount = readValue<quint16>(bytes, kSpawnCountOffset);
+    const qsizetype payloadSize = readValue<quint32>(bytes, kPayloadSizeOffset);
+    const qsizetype spawnBytes = static_cast<qsizetype>(spawnCount) * 4;
+    if (width <= 0 || height <= 0)
+        return fail(error, QStringLiteral("empty map"));
+    if (data.size() != kHeaderSize + spawnBytes + payloadSize)
+        return fail(error, QStringLiteral("truncated or oversized file"));
+
+    // Нестиснений масив адресується напряму, тож його довжина мусить точно збігатися з картою.
+    const quint16 flags = readValue<quint16>(bytes, kFlagsOffset);
+    if (!(flags & RunLengthEncoded) && payloadSize != static_cast<qsizetype>(width) * height)
+        return fail(error, QStringLiteral("tile count does not match map size"));
+
+    // Точки поза картою потрапили б у Map::setTile, сітку зайнятості й таблиці AI без перевірки меж.
+    const QRect bounds(0, 0, width, height);
+    const QPoint baseCell = readPoint(bytes + kBaseOffset);
+    const QPoint playerSpawn = readPoint(bytes + kPlayerOffset);
+    if (!bounds.contains(baseCell) || !bounds.contains(playerSpawn))
+        return fail(error, QStringLiteral("base or player spawn outside the map"));
+    QList<QPoint> enemySpawns;
+    enemySpawns.reserve(spawnCount);
+    for (int i = 0; i < spawnCount; ++i) {
+        const QPoint spawn = readPoint(bytes + kHeaderSize + i * 4);
+        if (!bounds.contains(spawn))
+            return fail(error, QStringLiteral("enemy spawn outside the map"));
+        enemySpawns.append(spawn);
+    }
+
+    header.flags = flags;
+    header.size = QSize(width, height);
+    header.baseCell = baseCell;
+    header.playerSpawn = playerSpawn;
+    header.enemySpawns = std::move(enemySpawns);
+    header.payloadOffset = kHeaderSize + spawnBytes;
+    header.payloadSize = payloadSize;
+    return true;
+}
+
+void BinaryLevelCodec::updateChecksum(char* data, qsizetype size)
+{
+    if (size < kHeaderSize)
+        return;
+    qToLittleEndian<quint32>(fnv1a(data + kHeaderSize, size - kHeaderSize), data + kChecksumOffset);
+}
+
+bool BinaryLevelCodec::decode(QByteArrayView data, LevelData& level, QString* error)
+{
+    BinaryLevelHeader header;
+    if (!readHeader(data, header, error))
+        return false;
+
+    const char* bytes = data.data();
+    const quint32 checksum = readValue<quint32>(bytes, kChecksumOffset);
+    if (fnv1a(bytes + kHeaderSize, data.size() - kHeaderSize) != checksum)
+        return fail(error, QStringLiteral("checksum mismatch"));
+
+    const int width = header.size.width();
+    const int height = header.size.height();
+    const qsizetype payloadSize = header.payloadSize;
+    auto map = std::make_unique<Map>(width, height);
+    const QByteArrayView payload = data.sliced(header.payloadOffset);
+    const qsizetype cellCount = static_cast<qsizetype>(width) * height;
+    if (header.flags & RunLengthEncoded) {
+        if (payloadSize % 2 != 0)
+            return fail(error, QStringLiteral("corrupt run-length data"));
+
+        QByteArray types;
+        types.reserve(cellCount);
+        for (qsizetype i = 0; i < payloadSize; i += 2) {
+            const int run = static_cast<quint8>(payload.at(i));
+            if (run == 0 || types.size() + run > cellCount)
+                return fail(error, QStringLiteral("corrupt run-length data"));
+            types.append(run, payload.at(i + 1));
+        }
+        if (!map->assignTileTypes(types))
+            return fail(error, QStringLiteral("tile count does not match map size"));
+    } else if (!map->assignTileTypes(payload)) {
+        return fail(error, QStringLiteral("tile count does not match map size"));
+    }
+
+    level.map = std::move(map);
+    level.baseCell = header.baseCell;
+    level.playerSpawn = header.playerSpawn;
+    level.enemySpawns = header.enemySpawns;
+    level.loadedFromFile = true;
+    return true;
+}
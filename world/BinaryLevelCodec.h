@@ -0,0 +1,57 @@
+#ifndef BINARYLEVELCODEC_H
+#define BINARYLEVELCODEC_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QPoint>
+#include <QSize>
+#include <QString>
+#include <QtGlobal>
+
+struct LevelData;
+
+// Розібраний заголовок і спавни без розпакування тайлів.
+struct BinaryLevelHeader
+{
+    quint16 flags = 0;
+    QSize size;
+    QPoint baseCell;
+    QPoint playerSpawn;
+    QList<QPoint> enemySpawns;
+    qsizetype payloadOffset = 0;    // зсув масиву тайлів від початку файлу
+    qsizetype payloadSize = 0;
+};
+
+/*
+ * BinaryLevelCodec — компактний двійковий формат рівня (*.gslv) поруч із текстовим.
+ * 32-байтний заголовок little-endian: magic "GSLV", версія, прапорці, розмір,
+ * база, спавн гравця, кількість спавнів ворогів, розмір даних і FNV-1a контрольна сума
+ * всього, що йде після заголовка. Далі — спавни ворогів (пари int16) і масив
+ * значень TileType по рядках, сирий або стиснений RLE (пари довжина/значення).
+ * Сирий масив передається в Map::assignTileTypes прямо з відображеного файлу.
+ */
+class BinaryLevelCodec
+{
+public:
+    static constexpr quint16 kVersion = 1;
+    static constexpr int kHeaderSize = 32;
+
+    enum Flag : quint16 {
+        NoFlags = 0,
+        RunLengthEncoded = 1 << 0
+    };
+
+    static QString fileSuffix() { return QStringLiteral("gslv"); }
+    static bool isBinaryLevel(QByteArrayView data);
+
+    // Перевіряє заголовок і розміри, але не контрольну суму — для потокового читання великих карт.
+    static bool readHeader(QByteArrayView data, BinaryLevelHeader& header, QString* error = nullptr);
+    // Перераховує контрольну суму після зміни файлу на місці.
+    static void updateChecksum(char* data, qsizetype size);
+
+    static QByteArray encode(const LevelData& level, bool compress);
+    static bool decode(QByteArrayView data, LevelData& level, QString* error = nullptr);
+};
+
+#endif // BINARYLEVELCODEC_H
@@ -0,0 +1,226 @@
+#include "world/LevelGenerator.h"
+
+#include <QVector>
+#include <QtGlobal>
+
+#include "world/Tile.h"
+
+namespace {
+constexpr int kBlockSize = 2;
+constexpr quint32 kDensityScale = 65536;
+
+constexpr char code(TileType type)
+{
+    return static_cast<char>(type);
+}
+
+quint64 splitMix64(quint64& state)
+{
+    quint64 z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+quint32 threshold(double density)
+{
+    return static_cast<quint32>(qBound(0.0, density, 1.0) * kDensityScale);
+}
+
+// Сталь і вода — постійні стіни; цеглу танк прострілює, тож вона не розриває зв'язність.
+bool isPassable(char value)
+{
+    return value != code(TileType::Steel) && value != code(TileType::Water);
+}
+
+class ByteGrid
+{
+public:
+    ByteGrid(QByteArray& data, int width, int height)
+        : m_data(data.data()), m_width(width), m_height(height)
+    {
+    }
+
+    bool isInterior(const QPoint& cell) const
+    {
+        return cell.x() > 0 && cell.y() > 0 && cell.x() < m_width - 1 && cell.y() < m_height - 1;
+    }
+    qsizetype index(int x, int y) const { return static_cast<qsizetype>(y) * m_width + x; }
+    char& at(const QPoint& cell) { return m_data[index(cell.x(), cell.y())]; }
+    char at(qsizetype index) const { return m_data[index]; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+    void setInterior(const QPoint& cell, TileType type)
+    {
+        if (isInterior(cell))
+            at(cell) = code(type);
+    }
+
+private:
+    char* m_data;
+    int m_width;
+    int m_height;
+};
+
+// Рядкова заливка від клітинок seeds, доповнює вже наявні позначки visited: кожен прохід
+// заповнює цілий горизонтальний відрізок і кладе в стек лише початки відрізків над і під ним.
+// Рамка завжди сталева, тож сусіди внутрішніх клітинок не виходять за межі — без перевірок координат.
+void flood(const ByteGrid& grid, const QVector<QPoint>& seeds, QByteArray& visited, QVector<qsizetype>& stack)
+{
+    const qsizetype width = grid.width();
+    const auto isOpen = [&grid, &visited](qsizetype index) {
+        return !visited.at(index) && isPassable(grid.at(index));
+    };
+
+    stack.clear();
+    for (const QPoint& seed : seeds)
+        stack.append(grid.index(seed.x(), seed.y()));
+
+    while (!stack.isEmpty()) {
+        const qsizetype seed = stack.takeLast();
+        if (!isOpen(seed))
+            continue;
+
+        qsizetype left = seed;
+        while (isOpen(left - 1))
+            --left;
+        qsizetype right = seed;
+        while (isOpen(right + 1))
+            ++right;
+        for (qsizetype index = left; index <= right; ++index)
+            visited[index] = 1;
+
+        for (const qsizetype rowOffset : {-width, width}) {
+            bool inRun = false;
+            for (qsizetype index = left; index <= right; ++index) {
+                const bool open = isOpen(index + rowOffset);
+                if (open && !inRun)
+                    stack.append(index + rowOffset);
+                inRun = open;
+            }
+        }
+    }
+}
+
+// Коридор спочатку по рядку спавну до колонки бази, потім по колонці до бази.
+QVector<QPoint> carveCorridor(ByteGrid& grid, const QPoint& from, const QPoint& base)
+{
+    QVector<QPoint> corridor;
+    corridor.reserve(qAbs(from.x() - base.x()) + qAbs(from.y() - base.y()) + 1);
+    const auto clear = [&grid, &corridor](const QPoint& target) {
+        char& value = grid.at(target);
+        if (!isPassable(value))
+            value = code(TileType::Empty);
+        corridor.append(target);
+    };
+
+    QPoint cell = from;
+    clear(cell);
+    while (cell.x() != base.x()) {
+        cell.rx() += cell.x() < base.x() ? 1 : -1;
+        clear(cell);
+    }
+    while (cell.y() != base.y()) {
+        cell.ry() += cell.y() < base.y() ? 1 : -1;
+        if (cell != base)
+            clear(cell);
+    }
+    return corridor;
+}
+} // namespace
+
+GeneratedLevel LevelGenerator::generate(const LevelGeneratorParams& params, const QPoint& baseCell,
+                                        const QPoint& playerSpawn, const QList<QPoint>& enemySpawns)
+{
+    GeneratedLevel level;
+    const int width = qMax(params.size.width(), 5);
+    const int height = qMax(params.size.height(), 5);
+    level.size = QSize(width, height);
+    level.tiles = QByteArray(static_cast<qsizetype>(width) * height, code(TileType::Empty));
+    ByteGrid grid(level.tiles, width, height);
+
+    // Випадкові блоки генеруються лише для незалежної частини карти; решта — дзеркало.
+    const bool mirrorX = params.symmetry != LevelSymmetry::None;
+    const bool mirrorY = params.symmetry == LevelSymmetry::MirrorXY;
+    const int regionWidth = mirrorX ? (width + 1) / 2 : width;
+    const int regionHeight = mirrorY ? (height + 1) / 2 : height;
+    // Блоки вирівняні по внутрішній частині, без сталевої рамки.
+    const int blocksX = (regionWidth + kBlockSize - 1) / kBlockSize;
+    const int blocksY = (regionHeight + kBlockSize - 1) / kBlockSize;
+
+    const quint32 brickLimit = threshold(params.brickDensity);
+    const quint32 steelLimit = brickLimit + threshold(params.steelDensity);
+    const quint32 waterLimit = steelLimit + threshold(params.waterDensity);
+    const quint32 forestLimit = waterLimit + threshold(params.forestDensity);
+    const quint32 iceLimit = forestLimit + threshold(params.iceDensity);
+
+    quint64 rngState = params.seed;
+    QByteArray blocks(static_cast<qsizetype>(blocksX) * blocksY, code(TileType::Empty));
+    for (char& block : blocks) {
+        const quint32 roll = static_cast<quint32>(splitMix64(rngState) % kDensityScale);
+        if (roll < brickLimit)
+            block = code(TileType::Brick);
+        else if (roll < steelLimit)
+            block = code(TileType::Steel);
+        else if (roll < waterLimit)
+            block = code(TileType::Water);
+        else if (roll < forestLimit)
+            block = code(TileType::Forest);
+        else if (roll < iceLimit)
+            block = code(TileType::Ice);
+    }
+
+    for (int y = 0; y < height; ++y) {
+        const int sourceY = (mirrorY && y >= regionHeight) ? height - 1 - y : y;
+        const char* blockRow = blocks.constData() + static_cast<qsizetype>(qMax(0, sourceY - 1) / kBlockSize) * blocksX;
+        char* row = level.tiles.data() + static_cast<qsizetype>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            const int sourceX = (mirrorX && x >= regionWidth) ? width - 1 - x : x;
+            const bool border = x == 0 || y == 0 || x == width - 1 || y == height - 1;
+            row[x] = border ? code(TileType::Steel) : blockRow[(sourceX - 1) / kBlockSize];
+        }
+    }
+
+    // База з цегляним захистом, потім спавни — вони мають пріоритет над захистом.
+    level.baseCell = grid.isInterior(baseCell) ? baseCell : QPoint(width / 2, height - 2);
+    for (int dy = -1; dy <= 0; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx)
+            grid.setInterior(level.baseCell + QPoint(dx, dy), TileType::Brick);
+    }
+    grid.at(level.baseCell) = code(TileType::Base);
+
+    static constexpr QPoint kNeighbours[4] = {QPoint(1, 0), QPoint(-1, 0), QPoint(0, 1), QPoint(0, -1)};
+    for (const QPoint& spawn : enemySpawns) {
+        if (!grid.isInterior(spawn) || spawn == level.baseCell)
+            continue;
+        grid.setInterior(spawn, TileType::Empty);
+        for (const QPoint& offset : kNeighbours) {
+            if (spawn + offset != level.baseCell)
+                grid.setInterior(spawn + offset, TileType::Empty);
+        }
+        level.enemySpawns.append(spawn);
+    }
+
+    level.playerSpawn = (grid.isInterior(playerSpawn) && playerSpawn != level.baseCell)
+        ? playerSpawn
+        : QPoint(qMax(1, level.baseCell.x() - 2), level.baseCell.y());
+    grid.setInterior(level.playerSpawn, TileType::Empty);
+
+    // Один flood fill перевіряє всі спавни; після прорізання коридору заливка лише
+    // продовжується від нього, тож сумарно кожна клітинка обходиться один раз.
+    QByteArray visited(level.tiles.size(), '\0');
+    QVector<qsizetype> stack;
+    flood(grid, QVector<QPoint>{level.baseCell}, visited, stack);
+
+    QList<QPoint> required = level.enemySpawns;
+    required.append(level.playerSpawn);
+    for (const QPoint& spawn : required) {
+        if (visited.at(grid.index(spawn.x(), spawn.y())))
+            continue;
+        flood(grid, carveCorridor(grid, spawn, level.baseCell), visited, stack);
+        ++level.repairedPaths;
+    }
+
+    return level;
+}
@@ -0,0 +1,53 @@
+#ifndef LEVELGENERATOR_H
+#define LEVELGENERATOR_H
+
+#include <QByteArray>
+#include <QList>
+#include <QPoint>
+#include <QSize>
+#include <QtGlobal>
+
+enum class LevelSymmetry {
+    None,
+    MirrorX,    // дзеркально ліворуч/праворуч
+    MirrorXY    // дзеркально по обох осях
+};
+
+struct LevelGeneratorParams
+{
+    quint64 seed = 1;
+    QSize size;                 // некоректний розмір — береться з GameRules
+    double brickDensity = 0.30;
+    double steelDensity = 0.05;
+    double waterDensity = 0.04;
+    double forestDensity = 0.06;
+    double iceDensity = 0.03;
+    LevelSymmetry symmetry = LevelSymmetry::MirrorX;
+};
+
+struct GeneratedLevel
+{
+    QSize size;
+    QByteArray tiles;           // значення TileType по рядках, готові для Map::assignTileTypes
+    QPoint baseCell;
+    QPoint playerSpawn;
+    QList<QPoint> enemySpawns;
+    int repairedPaths = 0;
+};
+
+/*
+ * LevelGenerator будує карту в стилі Battle City з зерна: блоки 2×2 заданих
+ * щільностей, сталева рамка, цегляний захист бази. Вся робота йде над масивом
+ * байтів TileType, тож 32×30 будується за мікросекунди, а 1024×1024 — за мілісекунди.
+ * Після заповнення один flood fill від бази перевіряє, що кожен спавн ворогів і гравця
+ * досяжний; цегла вважається прохідною (її прострілюють), сталь і вода — ні.
+ * Недосяжний спавн з'єднується з базою прорізаним коридором.
+ */
+class LevelGenerator
+{
+public:
+    static GeneratedLevel generate(const LevelGeneratorParams& params, const QPoint& baseCell,
+                                   const QPoint& playerSpawn, const QList<QPoint>& enemySpawns);
+};
+
+#endif // LEVELGENERATOR_H
@@ -0,0 +1,349 @@
+#include "world/LevelIndex.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <cstring>
+
+#include "core/GameRules.h"
+#include "world/BinaryLevelCodec.h"
+#include "world/LevelLoader.h"
+#include "world/LevelParser.h"
+
+namespace {
+constexpr char kMagic[4] = {'G', 'S', 'L', 'I'};
+constexpr quint16 kVersion = 2;
+// magic, версія, резерв, кількість записів
+constexpr qsizetype kHeaderSize = 12;
+// ширина, висота, розмір файлу, час зміни (після імені)
+constexpr qsizetype kEntryTailSize = 2 + 2 + 8 + 8;
+
+QString resolveMapsDirectory()
+{
+    const QString currentPath = QDir::currentPath();
+    const QStringList candidates = {
+        QStringLiteral("assets/maps"),
+        QStringLiteral("../assets/maps"),
+        QStringLiteral("../../assets/maps"),
+        QStringLiteral("../../../assets/maps"),
+    };
+
+    for (const QString& candidate : candidates) {
+        const QString absoluteCandidate = QDir(currentPath).absoluteFilePath(candidate);
+        const QDir dir(absoluteCandidate);
+        if (dir.exists() && dir.isReadable())
+            return dir.absolutePath();
+    }
+
+    return QDir(currentPath).absoluteFilePath(QStringLiteral("assets/maps"));
+}
+
+QString resolveSavedLevelPath()
+{
+    const QString relativePath = QStringLiteral("assets/maps/Demo.txt");
+    qInfo() << "LevelIndex: current working directory:" << QDir::currentPath();
+    const QString applicationDir = QCoreApplication::applicationDirPath();
+    qInfo() << "LevelIndex: applicationDirPath:" << applicationDir;
+
+    auto logCandidate = [](const QString& label, const QString& path) {
+        const QFileInfo info(path);
+        qInfo() << "LevelIndex:" << label << ":" << path
+                << "exists:" << info.exists() << "readable:" << info.isReadable();
+    };
+
+    const QString initialPath = QFileInfo(relativePath).absoluteFilePath();
+    logCandidate(QStringLiteral("initial candidate (working directory)"), initialPath);
+
+    const QList<QString> candidatePaths = {
+        QDir(applicationDir).absoluteFilePath(relativePath),
+        QDir(applicationDir).absoluteFilePath(QStringLiteral("../%1").arg(relativePath)),
+        QDir(applicationDir).absoluteFilePath(QStringLiteral("../../%1").arg(relativePath)),
+        QDir(applicationDir).absoluteFilePath(QStringLiteral("../../../%1").arg(relativePath)),
+        initialPath,
+    };
+
+    for (const QString& candidate : candidatePaths) {
+        logCandidate(QStringLiteral("candidate path"), candidate);
+        const QFileInfo info(candidate);
+        if (info.exists() && info.isReadable())
+            return info.absoluteFilePath();
+    }
+
+    qWarning() << "LevelIndex: no readable saved level found; using initial path" << initialPath;
+    return initialPath;
+}
+
+// Супутник лежить у каталозі кешу; ім'я залежить від шляху до карт, тож різні копії
+// ассетів не ділять один індекс. Порожній рядок — каталогу кешу немає.
+QString sidecarPath(const QString& mapsDirectory)
+{
+    const QString cacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cacheDirectory.isEmpty())
+        return QString();
+    const QByteArray digest = QCryptographicHash::hash(mapsDirectory.toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    return QDir(cacheDirectory).filePath(QStringLiteral("levels-%1.idx").arg(QString::fromLatin1(digest)));
+}
+
+QStringList scanLevelFiles(const QString& directory)
+{
+    const QDir dir(directory);
+    const QString binaryPattern = QStringLiteral("Level*.%1").arg(BinaryLevelCodec::fileSuffix());
+    QStringList entries = dir.entryList(QStringList() << QStringLiteral("Level*.txt") << binaryPattern,
+                                        QDir::Files, QDir::Name);
+
+    // Якщо поруч із текстовим рівнем лежить зконвертований двійковий, показуємо лише його.
+    QStringList levels;
+    levels.reserve(entries.size());
+    for (const QString& entry : entries) {
+        const QFileInfo info(entry);
+        if (info.suffix() != BinaryLevelCodec::fileSuffix()) {
+            const QString binaryName = info.completeBaseName() + QLatin1Char('.') + BinaryLevelCodec::fileSuffix();
+            if (entries.contains(binaryName))
+                continue;
+        }
+        levels.append(entry);
+    }
+
+    levels.sort(Qt::CaseInsensitive);
+    return levels;
+}
+
+// Розмір карти без розбору тайлів. Числовий текст LevelLoader кладе на поле GameRules::mapSize(),
+// тож досить упізнати його за першим токеном. Порожній результат — символьна легенда.
+std::optional<QSize> headerMapSize(QByteArrayView data, const GameRules& rules)
+{
+    if (BinaryLevelCodec::isBinaryLevel(data)) {
+        BinaryLevelHeader header;
+        if (!BinaryLevelCodec::readHeader(data, header))
+            return QSize();
+        return header.size;
+    }
+
+    LevelTokenizer tokenizer(data);
+    for (;;) {
+        const LevelTokenizer::Token token = tokenizer.next();
+        switch (token.kind) {
+        case LevelTokenizer::TokenKind::Number:
+            return rules.mapSize();
+        case LevelTokenizer::TokenKind::EndOfLine:
+            continue;
+        case LevelTokenizer::TokenKind::EndOfInput:
+        case LevelTokenizer::TokenKind::Invalid:
+            return std::nullopt;
+        }
+    }
+}
+
+template <typename T>
+void appendValue(QByteArray& buffer, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian<T>(value, bytes);
+    buffer.append(bytes, sizeof(T));
+}
+} // namespace
+
+LevelIndex& LevelIndex::instance()
+{
+    static LevelIndex index;
+    return index;
+}
+
+QString LevelIndex::mapsDirectory()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_mapsDirectory.isEmpty())
+        m_mapsDirectory = resolveMapsDirectory();
+    return m_mapsDirectory;
+}
+
+QString LevelIndex::savedLevelPath()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_savedLevelPath.isEmpty()) {
+        m_savedLevelPath = resolveSavedLevelPath();
+        qInfo() << "LevelIndex: resolved path to saved level:" << m_savedLevelPath;
+    }
+    return m_savedLevelPath;
+}
+
+QVector<LevelIndexEntry> LevelIndex::entries()
+{
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+    return m_entries;
+}
+
+QStringList LevelIndex::fileNames()
+{
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    QStringList names;
+    names.reserve(m_entries.size());
+    for (const LevelIndexEntry& entry : m_entries)
+        names.append(entry.fileName);
+    return names;
+}
+
+void LevelIndex::invalidate()
+{
+    QMutexLocker locker(&m_mutex);
+    m_loaded = false;
+    m_entries.clear();
+    if (m_mapsDirectory.isEmpty())
+        return;
+    const QString path = sidecarPath(m_mapsDirectory);
+    if (!path.isEmpty())
+        QFile::remove(path);
+}
+
+void LevelIndex::ensureLoaded()
+{
+    if (m_loaded)
+        return;
+
+    if (m_mapsDirectory.isEmpty())
+        m_mapsDirectory = resolveMapsDirectory();
+
+    const QString path = sidecarPath(m_mapsDirectory);
+    if (!readSidecar(path) || !matchesDirectory()) {
+        rebuild();
+        writeSidecar(path);
+    }
+    m_loaded = true;
+}
+
+bool LevelIndex::readSidecar(const QString& path)
+{
+    LevelFileBuffer buffer;
+    if (!buffer.open(path))
+        return false;
+
+    const QByteArrayView data = buffer.data();
+    const char* bytes = data.data();
+    if (data.size() < kHeaderSize || memcmp(bytes, kMagic, sizeof(kMagic)) != 0)
+        return false;
+    if (qFromLittleEndian<quint16>(bytes + 4) != kVersion)
+        return false;
+
+    const quint32 count = qFromLittleEndian<quint32>(bytes + 8);
+    QVector<LevelIndexEntry> entries;
+    entries.reserve(static_cast<qsizetype>(qMin<quint32>(count, 65536)));
+
+    qsizetype offset = kHeaderSize;
+    for (quint32 i = 0; i < count; ++i) {
+        if (offset + 2 > data.size())
+            return false;
+        const qsizetype nameLength = qFromLittleEndian<quint16>(bytes + offset);
+        offset += 2;
+        if (offset + nameLength + kEntryTailSize > data.size())
+            return false;
+
+        LevelIndexEntry entry;
+        entry.fileName = QString::fromUtf8(bytes + offset, nameLength);
+        offset += nameLength;
+        entry.size = QSize(qFromLittleEndian<quint16>(bytes + offset), qFromLittleEndian<quint16>(bytes + offset + 2));
+        entry.fileSize = qFromLittleEndian<qint64>(bytes + offset + 4);
+        entry.modifiedMs = qFromLittleEndian<qint64>(bytes + offset + 12);
+        offset += kEntryTailSize;
+        entries.append(entry);
+    }
+
+    m_entries = std::move(entries);
+    return true;
+}
+
+bool LevelIndex::matchesDirectory() const
+{
+    // Лише список імен і stat кожного файлу: додавання, видалення чи зміна рівня на місці
+    // змінює набір імен, довжину або час зміни.
+    const QStringList files = scanLevelFiles(m_mapsDirectory);
+    if (files.size() != m_entries.size())
+        return false;
+
+    const QDir dir(m_mapsDirectory);
+    for (qsizetype i = 0; i < files.size(); ++i) {
+        const LevelIndexEntry& entry = m_entries.at(i);
+        if (entry.fileName != files.at(i))
+            return false;
+        const QFileInfo info(dir.filePath(entry.fileName));
+        if (info.size() != entry.fileSize || info.lastModified().toMSecsSinceEpoch() != entry.modifiedMs)
+            return false;
+    }
+    return true;
+}
+
+void LevelIndex::rebuild()
+{
+    const QStringList files = scanLevelFiles(m_mapsDirectory);
+    const QDir dir(m_mapsDirectory);
+    const GameRules rules;
+
+    // Розмір — із заголовка (відображення торкається лише перших сторінок файлу),
+    // тож перебудова під м'ютексом не залежить від розміру карт.
+    QVector<LevelIndexEntry> entries;
+    entries.reserve(files.size());
+    for (const QString& fileName : files) {
+        const QString path = dir.filePath(fileName);
+        const QFileInfo info(path);
+        LevelIndexEntry entry;
+        entry.fileName = fileName;
+        entry.fileSize = info.size();
+        entry.modifiedMs = info.lastModified().toMSecsSinceEpoch();
+
+        LevelFileBuffer buffer;
+        if (buffer.open(path)) {
+            const std::optional<QSize> size = headerMapSize(buffer.data(), rules);
+            if (size.has_value()) {
+                entry.size = *size;
+            } else {
+                // Символьна легенда не має заголовка; такі рівні малі, тож їх розбираємо повністю.
+                const LevelData level = LevelLoader().loadLevelFile(path, rules);
+                if (level.map)
+                    entry.size = level.map->size();
+            }
+        }
+        entries.append(entry);
+    }
+
+    qInfo() << "LevelIndex: indexed" << entries.size() << "levels in" << m_mapsDirectory;
+    m_entries = std::move(entries);
+}
+
+void LevelIndex::writeSidecar(const QString& path) const
+{
+    QByteArray buffer;
+    buffer.reserve(kHeaderSize + m_entries.size() * (16 + kEntryTailSize));
+    buffer.append(kMagic, sizeof(kMagic));
+    appendValue<quint16>(buffer, kVersion);
+    appendValue<quint16>(buffer, 0);
+    appendValue<quint32>(buffer, static_cast<quint32>(m_entries.size()));
+
+    for (const LevelIndexEntry& entry : m_entries) {
+        const QByteArray name = entry.fileName.toUtf8();
+        appendValue<quint16>(buffer, static_cast<quint16>(name.size()));
+        buffer.append(name);
+        appendValue<quint16>(buffer, static_cast<quint16>(qMax(0, entry.size.width())));
+        appendValue<quint16>(buffer, static_cast<quint16>(qMax(0, entry.size.height())));
+        appendValue<qint64>(buffer, entry.fileSize);
+        appendValue<qint64>(buffer, entry.modifiedMs);
+    }
+
+    // Супутник — лише кеш: якщо записати не вдалося, індекс живе в пам'яті до кінця процесу.
+    if (path.isEmpty()) {
+        qInfo() << "LevelIndex: no cache directory, level index is kept in memory only";
+        return;
+    }
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(buffer) != buffer.size())
+        qInfo() << "LevelIndex: level index is kept in memory only:" << file.errorString();
+}
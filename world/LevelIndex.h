@@ -0,0 +1,60 @@
+#ifndef LEVELINDEX_H
+#define LEVELINDEX_H
+
+#include <QMutex>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+#include <optional>
+
+struct LevelIndexEntry
+{
+    QString fileName;
+    QSize size;
+    qint64 fileSize = 0;
+    qint64 modifiedMs = 0;   // час зміни файлу, мс від епохи
+};
+
+/*
+ * LevelIndex — каталог рівнів із assets/maps, який читається один раз за процес.
+ * Назви, розміри, довжини й часи зміни рівнів зберігаються у файлі-супутнику в каталозі
+ * кешу користувача (каталог карт може бути лише для читання). Супутник свіжий, доки набір рівнів у каталозі той самий і кожен
+ * файл має записані довжину й час зміни; інакше індекс перебудовується. Розмір карти
+ * при перебудові береться із заголовка файлу, без повного завантаження рівня.
+ * Потокобезпечний: ним користуються і меню, і фонове завантаження рівнів.
+ */
+class LevelIndex
+{
+public:
+    static LevelIndex& instance();
+
+    QString mapsDirectory();
+    // Шлях до збереженого рівня (Demo.txt), знайдений один раз серед кандидатів.
+    QString savedLevelPath();
+
+    QVector<LevelIndexEntry> entries();
+    std::optional<LevelIndexEntry> entry(int index);
+    QStringList fileNames();
+
+    // Скидає кеш і супутник, наприклад після збереження рівня з редактора.
+    void invalidate();
+
+private:
+    LevelIndex() = default;
+
+    void ensureLoaded();
+    bool readSidecar(const QString& path);
+    bool matchesDirectory() const;
+    void rebuild();
+    void writeSidecar(const QString& path) const;
+
+    QMutex m_mutex;
+    bool m_loaded = false;
+    QString m_mapsDirectory;
+    QString m_savedLevelPath;
+    QVector<LevelIndexEntry> m_entries;
+};
+
+#endif // LEVELINDEX_H
@@ -5,19 +5,24 @@
 #include <optional>
 #include <utility>
 
-#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
-#include <QFile>
 #include <QFileInfo>
-#include <QRegularExpression>
+#include <QSaveFile>
 #include <QStringList>
-#include <QTextStream>
 
+#include "world/BinaryLevelCodec.h"
+#include "world/LevelGenerator.h"
+#include "world/LevelIndex.h"
+#include "world/LevelParser.h"
+#include "world/MapChunkStore.h"
 #include "world/Tile.h"
 #include "world/Wall.h"
 
 namespace {
+// Нестиснені двійкові рівні від цього розміру (≈2048×2048) не читаються цілком, а підвантажуються чанками.
+constexpr qint64 kStreamingMinBytes = 4 * 1024 * 1024;
+
 QPoint defaultPlayerSpawn(const QSize& size, const QPoint& baseCell)
 {
     const QPoint leftOfBase(baseCell.x() - 2, baseCell.y());
@@ -43,21 +48,6 @@ std::array<QPoint, 3> defaultEnemySpawns(const QSize& size)
     return {QPoint(left, y), QPoint(center, y), QPoint(right, y)};
 }
 
-Tile tileForType(TileType type)
-{
-    switch (type) {
-    case TileType::Empty: return TileFactory::empty();
-    case TileType::Brick: return TileFactory::brick();
-    case TileType::Steel: return TileFactory::steel();
-    case TileType::Forest: return TileFactory::forest();
-    case TileType::Water: return TileFactory::water();
-    case TileType::Ice: return TileFactory::ice();
-    case TileType::Base: return TileFactory::base();
-    }
-
-    Q_UNREACHABLE();
-}
-
 std::optional<TileType> tileTypeFromCode(int code)
 {
     switch (code) {
@@ -74,83 +64,27 @@ std::optional<TileType> tileTypeFromCode(int code)
     return std::nullopt;
 }
 
-bool parseNumericLevel(QTextStream& stream, const GameRules& rules, QSize& declaredSize, QVector<QVector<int>>& rows)
-{
-    declaredSize = rules.mapSize();
-    bool sizeParsed = false;
-
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QString trimmed = line.trimmed();
-        if (trimmed.isEmpty())
-            continue;
-
-        const QStringList parts = trimmed.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-        if (!sizeParsed && parts.size() >= 2) {
-            bool okWidth = false;
-            bool okHeight = false;
-            const int width = parts.at(0).toInt(&okWidth);
-            const int height = parts.at(1).toInt(&okHeight);
-            if (okWidth && okHeight && width > 0 && height > 0) {
-                declaredSize = QSize(width, height);
-                sizeParsed = true;
-                continue;
-            }
-        }
-
-        QVector<int> row;
-        row.reserve(parts.size());
-        for (const QString& part : parts) {
-            bool ok = false;
-            const int value = part.toInt(&ok);
-            if (!ok)
-                continue;
-            row.append(value);
-        }
-
-        if (!row.isEmpty())
-            rows.append(std::move(row));
-    }
-
-    return sizeParsed || !rows.isEmpty();
-}
-
-LevelData loadLevelFromNumeric(const QVector<QVector<int>>& rows, const QSize& declaredSize, const GameRules& rules, LevelData fallback)
+// Числовий формат: клітинки пишуться в Map прямо з токенізатора.
+// Порожній результат — вміст не схожий на числовий формат або містить помилку (див. result).
+std::optional<LevelData> loadNumericLevel(QByteArrayView bytes, const GameRules& rules, NumericLevelParser::Result& result)
 {
     const QSize mapSize = rules.mapSize();
     LevelData data;
     data.map = std::make_unique<Map>(mapSize);
     data.baseCell = rules.baseCell();
     data.playerSpawn = defaultPlayerSpawn(mapSize, data.baseCell);
-    const std::array<QPoint, 3> spawnDefaults = defaultEnemySpawns(mapSize);
-    for (const QPoint& spawn : spawnDefaults)
-        data.enemySpawns.append(spawn);
     data.loadedFromFile = true;
 
-    const int width = mapSize.width();
-    const int height = mapSize.height();
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            const QPoint cell(x, y);
-            data.map->setTile(cell, TileFactory::empty());
-        }
-    }
+    Map& map = *data.map;
+    result = NumericLevelParser::parse(bytes, [&map](int x, int y, int code) {
+        const std::optional<TileType> type = tileTypeFromCode(code);
+        if (!type.has_value() || *type == TileType::Base || *type == TileType::Empty)
+            return;
 
-    const int appliedHeight = std::min({height, declaredSize.height(), static_cast<int>(rows.size())});
-    for (int y = 0; y < appliedHeight; ++y) {
-        const QVector<int>& row = rows.at(y);
-        const int appliedWidth = std::min({width, declaredSize.width(), static_cast<int>(row.size())});
-        for (int x = 0; x < appliedWidth; ++x) {
-            const int code = row.at(x);
-            const std::optional<TileType> type = tileTypeFromCode(code);
-            if (!type.has_value() || *type == TileType::Base)
-                continue;
-
-            const QPoint cell(x, y);
-            data.map->setTile(cell, tileForType(*type));
-        }
-    }
+        map.setTile(QPoint(x, y), TileFactory::forType(*type));
+    });
+    if (!result.ok || result.error.isValid())
+        return std::nullopt;
 
     if (data.map->isInside(data.baseCell))
         data.map->setTile(data.baseCell, TileFactory::base());
@@ -188,10 +122,19 @@ LevelData loadLevelFromNumeric(const QVector<QVector<int>>& rows, const QSize& d
         data.enemySpawns.append(spawn);
     }
 
-    if (data.map)
-        return data;
+    return data;
+}
 
-    return std::move(fallback);
+QStringList splitTextLines(QByteArrayView bytes)
+{
+    QStringList lines = QString::fromUtf8(bytes.data(), bytes.size()).split(QLatin1Char('\n'));
+    if (!lines.isEmpty() && lines.constLast().isEmpty())
+        lines.removeLast();
+    for (QString& line : lines) {
+        if (line.endsWith(QLatin1Char('\r')))
+            line.chop(1);
+    }
+    return lines;
 }
 } // namespace
 
@@ -287,143 +230,173 @@ LevelData LevelLoader::loadFromText(const QStringList& lines, const GameRules& r
     return data;
 }
 
-namespace {
-QString mapsDirectory()
+LevelData LevelLoader::loadLevelByName(const QString& fileName, const GameRules& rules) const
 {
-    const QString currentPath = QDir::currentPath();
-    const QStringList candidates = {
-        QStringLiteral("assets/maps"),
-        QStringLiteral("../assets/maps"),
-        QStringLiteral("../../assets/maps"),
-        QStringLiteral("../../../assets/maps"),
-    };
+    const QString baseDir = LevelIndex::instance().mapsDirectory();
+    const QFileInfo info(QDir(baseDir).filePath(fileName));
+    if (!info.exists() || !info.isReadable())
+        return loadDefaultLevel(rules);
 
-    for (const QString& candidate : candidates) {
-        const QString absoluteCandidate = QDir(currentPath).absoluteFilePath(candidate);
-        const QDir dir(absoluteCandidate);
-        if (dir.exists() && dir.isReadable())
-            return dir.absolutePath();
-    }
+    QString error;
+    LevelData data = loadLevelFile(info.absoluteFilePath(), rules, &error);
+    if (data.map)
+        return data;
 
-    return QDir(currentPath).absoluteFilePath(QStringLiteral("assets/maps"));
+    if (!error.isEmpty())
+        qWarning() << "LevelLoader:" << fileName << error;
+    return loadDefaultLevel(rules);
 }
 
-QStringList scanLevelFiles()
+LevelData LevelLoader::loadLevelFile(const QString& filePath, const GameRules& rules, QString* error) const
 {
-    const QDir dir(mapsDirectory());
-    QStringList entries = dir.entryList(QStringList() << QStringLiteral("Level*.txt"), QDir::Files, QDir::Name);
-    entries.sort(Qt::CaseInsensitive);
-    return entries;
-}
-} // namespace
-
-LevelData LevelLoader::loadLevelByName(const QString& fileName, const GameRules& rules) const
-{
-    LevelData fallback = loadDefaultLevel(rules);
-
-    const QString baseDir = mapsDirectory();
-    const QFileInfo info(QDir(baseDir).filePath(fileName));
-    if (!info.exists() || !info.isReadable())
-        return fallback;
+    // Стиснений, недвійковий файл або ФС без mmap — звичайне завантаження нижче.
+    if (QFileInfo(filePath).size() >= kStreamingMinBytes) {
+        auto store = std::make_unique<MapChunkStore>();
+        if (store->open(filePath, rules.persistentWorld())) {
+            const BinaryLevelHeader& header = store->header();
+            LevelData data;
+            data.map = std::make_unique<Map>(header.size);
+            data.baseCell = header.baseCell;
+            data.playerSpawn = header.playerSpawn;
+            data.enemySpawns = header.enemySpawns;
+            data.loadedFromFile = true;
+            data.map->attachStore(std::move(store));
+            return data;
+        }
+    }
 
-    QFile file(info.absoluteFilePath());
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        return fallback;
+    LevelFileBuffer buffer;
+    if (!buffer.open(filePath)) {
+        if (error)
+            *error = buffer.errorString();
+        return LevelData();
+    }
 
-    QTextStream stream(&file);
-    QVector<QVector<int>> rows;
-    QSize declaredSize;
-    if (parseNumericLevel(stream, rules, declaredSize, rows)) {
-        return loadLevelFromNumeric(rows, declaredSize, rules, std::move(fallback));
+    // Двійковий рівень: тайли беруться прямо з відображеного файлу.
+    if (BinaryLevelCodec::isBinaryLevel(buffer.data())) {
+        LevelData data;
+        if (!BinaryLevelCodec::decode(buffer.data(), data, error))
+            return LevelData();
+        return data;
     }
 
-    file.seek(0);
-    QStringList lines;
-    while (!stream.atEnd())
-        lines.append(stream.readLine());
+    NumericLevelParser::Result result;
+    std::optional<LevelData> numeric = loadNumericLevel(buffer.data(), rules, result);
+    if (numeric.has_value())
+        return std::move(*numeric);
+
+    // Помилка після розпізнаного заголовка чи рядка — зіпсований числовий файл,
+    // інакше це символьна легенда.
+    if (result.hasHeader || result.rowCount > 0) {
+        if (error)
+            *error = result.error.toString();
+        return LevelData();
+    }
 
-    LevelData data = loadFromText(lines, rules);
+    LevelData data = loadFromText(splitTextLines(buffer.data()), rules);
     data.loadedFromFile = true;
+    return data;
+}
 
-    if (data.map)
-        return data;
+bool LevelLoader::convertToBinary(const QString& sourcePath, const QString& targetPath, const GameRules& rules,
+                                  bool compress, QString* error) const
+{
+    const LevelData level = loadLevelFile(sourcePath, rules, error);
+    if (!level.map)
+        return false;
+
+    QSaveFile file(targetPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
 
-    return fallback;
+    file.write(BinaryLevelCodec::encode(level, compress));
+    if (!file.commit()) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+    return true;
 }
 
 LevelData LevelLoader::loadLevelByIndex(int index, const GameRules& rules) const
 {
-    const QStringList files = scanLevelFiles();
-    if (files.isEmpty())
+    const QVector<LevelIndexEntry> levels = LevelIndex::instance().entries();
+    if (levels.isEmpty())
         return loadDefaultLevel(rules);
 
-    const qsizetype clampedIndex = std::clamp<qsizetype>(static_cast<qsizetype>(index), 0, files.size() - 1);
-    return loadLevelByName(files.at(clampedIndex), rules);
+    const qsizetype clampedIndex = std::clamp<qsizetype>(static_cast<qsizetype>(index), 0, levels.size() - 1);
+    return loadLevelByName(levels.at(clampedIndex).fileName, rules);
 }
 
 QStringList LevelLoader::availableLevelFiles() const
 {
-    return scanLevelFiles();
+    return LevelIndex::instance().fileNames();
+}
+
+QVector<LevelIndexEntry> LevelLoader::availableLevels() const
+{
+    return LevelIndex::instance().entries();
 }
 
 LevelData LevelLoader::loadSavedLevel(const GameRules& rules) const
 {
     LevelData fallback = loadDefaultLevel(rules);
 
-    const QString relativePath = QStringLiteral("assets/maps/Demo.txt");
-    qInfo() << "LevelLoader: current working directory:" << QDir::currentPath();
-    const QString applicationDir = QCoreApplication::applicationDirPath();
-    qInfo() << "LevelLoader: applicationDirPath:" << applicationDir;
-
-    auto logCandidate = [](const QString& label, const QString& path) {
-        const QFileInfo info(path);
-        qInfo() << "LevelLoader:" << label << ":" << path
-                << "exists:" << info.exists() << "readable:" << info.isReadable();
-    };
-
-    const QString initialPath = QFileInfo(relativePath).absoluteFilePath();
-    logCandidate(QStringLiteral("initial candidate (working directory)"), initialPath);
+    const QString resolvedPath = LevelIndex::instance().savedLevelPath();
 
-    const QList<QString> candidatePaths = {
-        QDir(applicationDir).absoluteFilePath(relativePath),
-        QDir(applicationDir).absoluteFilePath(QStringLiteral("../%1").arg(relativePath)),
-        QDir(applicationDir).absoluteFilePath(QStringLiteral("../../%1").arg(relativePath)),
-        QDir(applicationDir).absoluteFilePath(QStringLiteral("../../../%1").arg(relativePath)),
-        initialPath,
-    };
-
-    QString resolvedPath;
-    for (const QString& candidate : candidatePaths) {
-        logCandidate(QStringLiteral("candidate path"), candidate);
-        const QFileInfo info(candidate);
-        if (info.exists() && info.isReadable()) {
-            resolvedPath = info.absoluteFilePath();
-            break;
-        }
+    LevelFileBuffer buffer;
+    if (!buffer.open(resolvedPath)) {
+        qWarning() << "LevelLoader: failed to open saved level:" << buffer.errorString();
+        qWarning() << "LevelLoader: falling back to default level";
+        return fallback;
     }
 
-    if (resolvedPath.isEmpty()) {
-        resolvedPath = initialPath;
-        qWarning() << "LevelLoader: no readable saved level found; using initial path"
-                   << resolvedPath;
+    if (BinaryLevelCodec::isBinaryLevel(buffer.data())) {
+        LevelData data;
+        QString error;
+        if (BinaryLevelCodec::decode(buffer.data(), data, &error))
+            return data;
+        qWarning() << "LevelLoader: malformed saved level" << error;
+        return fallback;
     }
 
-    qInfo() << "LevelLoader: resolved path to saved level:" << resolvedPath;
-
-    QFile file(resolvedPath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "LevelLoader: failed to open saved level:" << file.errorString();
-        qWarning() << "LevelLoader: falling back to default level";
+    NumericLevelParser::Result result;
+    std::optional<LevelData> numeric = loadNumericLevel(buffer.data(), rules, result);
+    if (!numeric.has_value()) {
+        if (result.error.isValid())
+            qWarning() << "LevelLoader: malformed saved level" << result.error.toString();
         return fallback;
     }
 
-    QTextStream stream(&file);
-    QVector<QVector<int>> rows;
-    QSize declaredSize;
-    if (!parseNumericLevel(stream, rules, declaredSize, rows))
-        return fallback;
+    return std::move(*numeric);
+}
+
+LevelData LevelLoader::generateLevel(const LevelGeneratorParams& params, const GameRules& rules) const
+{
+    LevelGeneratorParams resolved = params;
+    if (resolved.size.isEmpty())
+        resolved.size = rules.mapSize();
+
+    // База з правил, якщо розмір збігається; інакше генератор поставить її по центру внизу.
+    const QSize size = resolved.size;
+    const QPoint base = size == rules.mapSize() ? rules.baseCell() : QPoint(size.width() / 2, size.height() - 2);
+    QList<QPoint> enemySpawns;
+    for (const QPoint& spawn : defaultEnemySpawns(size))
+        enemySpawns.append(spawn);
+
+    GeneratedLevel generated = LevelGenerator::generate(resolved, base, defaultPlayerSpawn(size, base), enemySpawns);
 
-    return loadLevelFromNumeric(rows, declaredSize, rules, std::move(fallback));
+    LevelData data;
+    data.map = std::make_unique<Map>(generated.size);
+    data.map->assignTileTypes(generated.tiles);
+    data.baseCell = generated.baseCell;
+    data.playerSpawn = generated.playerSpawn;
+    data.enemySpawns = generated.enemySpawns;
+    data.procedural = true;
+    return data;
 }
 
 LevelData LevelLoader::loadDefaultLevel(const GameRules& rules) const
@@ -5,11 +5,15 @@
 #include <QPoint>
 #include <QString>
 #include <QStringList>
+#include <QVector>
 #include <memory>
 
 #include "world/Map.h"
 #include "core/GameRules.h"
 
+struct LevelGeneratorParams;
+struct LevelIndexEntry;
+
 struct LevelData
 {
     std::unique_ptr<Map> map;
@@ -17,6 +21,7 @@ struct LevelData
     QList<QPoint> enemySpawns;
     QPoint baseCell;
     bool loadedFromFile = false;
+    bool procedural = false;
 };
 
 /*
@@ -30,9 +35,18 @@ public:
     LevelData loadDefaultLevel(const GameRules& rules) const;
     LevelData loadLevelByName(const QString& fileName, const GameRules& rules) const;
     LevelData loadLevelByIndex(int index, const GameRules& rules) const;
+    // Завантажує текстовий, числовий або двійковий (*.gslv) рівень за повним шляхом.
+    // При помилці повертає LevelData без карти й опис у error.
+    LevelData loadLevelFile(const QString& filePath, const GameRules& rules, QString* error = nullptr) const;
+    bool convertToBinary(const QString& sourcePath, const QString& targetPath, const GameRules& rules,
+                         bool compress, QString* error = nullptr) const;
     QStringList availableLevelFiles() const;
+    // Назви й розміри рівнів з індексу LevelIndex, без звернення до файлів.
+    QVector<LevelIndexEntry> availableLevels() const;
     LevelData loadFromText(const QStringList& lines, const GameRules& rules) const;
     LevelData loadSavedLevel(const GameRules& rules) const;
+    // Процедурна карта з зерна; спавни з defaultEnemySpawns гарантовано досяжні до бази.
+    LevelData generateLevel(const LevelGeneratorParams& params, const GameRules& rules) const;
 };
 
 #endif // LEVELLOADER_H
@@ -0,0 +1,148 @@
+#include "world/LevelParser.h"
+
+#include <limits>
+
+namespace {
+bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+} // namespace
+
+QString LevelParseError::toString() const
+{
+    return QStringLiteral("%1:%2: %3").arg(line).arg(column).arg(message);
+}
+
+LevelTokenizer::LevelTokenizer(QByteArrayView data)
+    : m_cursor(data.data())
+    , m_end(data.data() + data.size())
+    , m_lineStart(data.data())
+{
+    // UTF-8 BOM від деяких редакторів
+    if (data.size() >= 3 && static_cast<uchar>(m_cursor[0]) == 0xEF
+        && static_cast<uchar>(m_cursor[1]) == 0xBB && static_cast<uchar>(m_cursor[2]) == 0xBF) {
+        m_cursor += 3;
+        m_lineStart = m_cursor;
+    }
+}
+
+LevelTokenizer::Token LevelTokenizer::next()
+{
+    while (m_cursor < m_end && isBlank(*m_cursor))
+        ++m_cursor;
+
+    Token token;
+    token.line = m_line;
+    token.column = columnOf(m_cursor);
+
+    if (m_cursor >= m_end) {
+        token.kind = TokenKind::EndOfInput;
+        return token;
+    }
+
+    if (*m_cursor == '\n') {
+        token.kind = TokenKind::EndOfLine;
+        ++m_cursor;
+        ++m_line;
+        m_lineStart = m_cursor;
+        return token;
+    }
+
+    const char* start = m_cursor;
+    bool negative = false;
+    if (*m_cursor == '-' || *m_cursor == '+') {
+        negative = *m_cursor == '-';
+        ++m_cursor;
+    }
+
+    if (m_cursor >= m_end || !isDigit(*m_cursor)) {
+        token.kind = TokenKind::Invalid;
+        m_lastError = QStringLiteral("unexpected character '%1'").arg(QString(QChar(*start)));
+        m_cursor = start;
+        return token;
+    }
+
+    qint64 value = 0;
+    constexpr qint64 kMaxValue = std::numeric_limits<int>::max();
+    while (m_cursor < m_end && isDigit(*m_cursor)) {
+        value = value * 10 + (*m_cursor - '0');
+        if (value > kMaxValue) {
+            token.kind = TokenKind::Invalid;
+            m_lastError = QStringLiteral("number out of range");
+            return token;
+        }
+        ++m_cursor;
+    }
+
+    // Число має закінчуватися пробілом або кінцем рядка: "12a" — помилка, а не 12.
+    if (m_cursor < m_end && !isBlank(*m_cursor) && *m_cursor != '\n') {
+        token.kind = TokenKind::Invalid;
+        token.column = columnOf(m_cursor);
+        m_lastError = QStringLiteral("unexpected character '%1'").arg(QString(QChar(*m_cursor)));
+        return token;
+    }
+
+    token.kind = TokenKind::Number;
+    token.value = static_cast<int>(negative ? -value : value);
+    return token;
+}
+
+LevelParseError LevelTokenizer::errorFor(const Token& token) const
+{
+    LevelParseError error;
+    error.line = token.line;
+    error.column = token.column;
+    error.message = m_lastError;
+    return error;
+}
+
+int LevelTokenizer::columnOf(const char* position) const
+{
+    return static_cast<int>(position - m_lineStart) + 1;
+}
+
+LevelFileBuffer::~LevelFileBuffer()
+{
+    close();
+}
+
+bool LevelFileBuffer::open(const QString& filePath)
+{
+    close();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    if (size > 0)
+        m_mapped = m_file.map(0, size);
+
+    if (m_mapped) {
+        m_data = QByteArrayView(m_mapped, static_cast<qsizetype>(size));
+    } else {
+        // ФС без mmap (ресурси Qt, спецфайли) — одне читання в пам'ять.
+        m_contents = m_file.readAll();
+        m_data = QByteArrayView(m_contents);
+    }
+    return true;
+}
+
+void LevelFileBuffer::close()
+{
+    if (m_mapped) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    m_file.close();
+    m_contents.clear();
+    m_data = QByteArrayView();
+    m_errorString.clear();
+}
@@ -0,0 +1,174 @@
+#ifndef LEVELPARSER_H
+#define LEVELPARSER_H
+
+#include <QByteArrayView>
+#include <QFile>
+#include <QSize>
+#include <QString>
+#include <QVarLengthArray>
+#include <QtGlobal>
+
+// Позиція та опис першої помилки у файлі рівня (рядки й стовпці — з 1).
+struct LevelParseError
+{
+    int line = 0;
+    int column = 0;
+    QString message;
+
+    bool isValid() const { return line > 0; }
+    QString toString() const;
+};
+
+/*
+ * LevelTokenizer — потоковий токенізатор числового формату рівнів.
+ * Працює прямо по байтовому буферу (відображений файл або один read),
+ * без QString, регулярних виразів і проміжних рядків: видає цілі числа
+ * та кінці рядків разом із позицією для повідомлень про помилки.
+ */
+class LevelTokenizer
+{
+public:
+    enum class TokenKind {
+        Number,
+        EndOfLine,
+        EndOfInput,
+        Invalid
+    };
+
+    struct Token
+    {
+        TokenKind kind = TokenKind::EndOfInput;
+        int value = 0;
+        int line = 0;
+        int column = 0;
+    };
+
+    explicit LevelTokenizer(QByteArrayView data);
+
+    Token next();
+    LevelParseError errorFor(const Token& token) const;
+
+private:
+    int columnOf(const char* position) const;
+
+    const char* m_cursor = nullptr;
+    const char* m_end = nullptr;
+    const char* m_lineStart = nullptr;
+    int m_line = 1;
+    QString m_lastError;
+};
+
+/*
+ * NumericLevelParser — спільний розбір формату "W H" + матриця кодів тайлів
+ * для LevelLoader і LevelEditor. Кожна клітинка одразу передається у sink(x, y, code),
+ * тож викликач пише просто в Map без проміжних матриць.
+ * Заголовок розміру — лише перший непорожній рядок із щонайменше двома додатними числами;
+ * клітинки поза оголошеним розміром пропускаються.
+ */
+class NumericLevelParser
+{
+public:
+    struct Result
+    {
+        bool ok = false;          // знайдено заголовок або хоча б один рядок матриці
+        bool hasHeader = false;
+        QSize declaredSize;
+        int rowCount = 0;
+        LevelParseError error;    // заповнюється при некоректному вводі
+    };
+
+    template <typename CellSink>
+    static Result parse(QByteArrayView data, CellSink&& sink);
+};
+
+/*
+ * LevelFileBuffer — вміст файлу рівня одним буфером: QFile::map, якщо ОС дозволяє,
+ * інакше одне читання readAll. Буфер живе, доки живе об'єкт.
+ */
+class LevelFileBuffer
+{
+public:
+    LevelFileBuffer() = default;
+    ~LevelFileBuffer();
+    LevelFileBuffer(const LevelFileBuffer&) = delete;
+    LevelFileBuffer& operator=(const LevelFileBuffer&) = delete;
+
+    bool open(const QString& filePath);
+    QByteArrayView data() const { return m_data; }
+    QString errorString() const { return m_errorString; }
+
+private:
+    void close();
+
+    QFile m_file;
+    uchar* m_mapped = nullptr;
+    QByteArray m_contents;
+    QByteArrayView m_data;
+    QString m_errorString;
+};
+
+template <typename CellSink>
+NumericLevelParser::Result NumericLevelParser::parse(QByteArrayView data, CellSink&& sink)
+{
+    using TokenKind = LevelTokenizer::TokenKind;
+
+    Result result;
+    LevelTokenizer tokenizer(data);
+
+    // Перший непорожній рядок буферизується: це або заголовок, або рядок матриці.
+    QVarLengthArray<int, 64> firstLine;
+    bool firstLineDone = false;
+    int x = 0;
+    bool rowHasCells = false;
+
+    const auto finishFirstLine = [&]() {
+        firstLineDone = true;
+        if (firstLine.size() >= 2 && firstLine.at(0) > 0 && firstLine.at(1) > 0) {
+            result.hasHeader = true;
+            result.declaredSize = QSize(firstLine.at(0), firstLine.at(1));
+            return;
+        }
+
+        for (qsizetype i = 0; i < firstLine.size(); ++i)
+            sink(static_cast<int>(i), 0, firstLine.at(i));
+        result.rowCount = 1;
+    };
+
+    for (;;) {
+        const LevelTokenizer::Token token = tokenizer.next();
+        switch (token.kind) {
+        case TokenKind::Invalid:
+            result.error = tokenizer.errorFor(token);
+            return result;
+
+        case TokenKind::Number:
+            if (!firstLineDone) {
+                firstLine.append(token.value);
+                break;
+            }
+            if (!result.hasHeader || (x < result.declaredSize.width() && result.rowCount < result.declaredSize.height()))
+                sink(x, result.rowCount, token.value);
+            ++x;
+            rowHasCells = true;
+            break;
+
+        case TokenKind::EndOfLine:
+        case TokenKind::EndOfInput:
+            if (!firstLineDone) {
+                if (!firstLine.isEmpty())
+                    finishFirstLine();
+            } else if (rowHasCells) {
+                ++result.rowCount;
+                rowHasCells = false;
+            }
+            x = 0;
+            if (token.kind == TokenKind::EndOfInput) {
+                result.ok = result.hasHeader || result.rowCount > 0;
+                return result;
+            }
+            break;
+        }
+    }
+}
+
+#endif // LEVELPARSER_H
@@ -0,0 +1,78 @@
+#include "world/LevelPreloader.h"
+
+#include <QtConcurrent>
+
+namespace {
+// Підсвічений рівень, наступний рівень кампанії та кілька попередніх виборів у меню.
+constexpr qsizetype kMaxSlots = 4;
+} // namespace
+
+LevelPreloader::~LevelPreloader()
+{
+    // Завдання не посилаються на this, але не лишаємо читання файлів після знищення гри.
+    for (Slot& slot : m_slots)
+        slot.future.waitForFinished();
+}
+
+void LevelPreloader::request(int key, const GameRules& rules)
+{
+    if (findSlot(key, rules) >= 0)
+        return;
+
+    // Застарілий результат для тих самих ключа, але інших правил більше не знадобиться.
+    for (qsizetype i = m_slots.size() - 1; i >= 0; --i) {
+        if (m_slots.at(i).key == key)
+            m_slots.removeAt(i);
+    }
+    if (m_slots.size() >= kMaxSlots)
+        m_slots.removeFirst();
+
+    Slot slot;
+    slot.key = key;
+    slot.mapSize = rules.mapSize();
+    slot.baseCell = rules.baseCell();
+    slot.persistentWorld = rules.persistentWorld();
+    slot.future = QtConcurrent::run([key, rules]() {
+        const LevelLoader loader;
+        auto level = std::make_shared<LevelData>(key == kSavedLevel ? loader.loadSavedLevel(rules)
+                                                                    : loader.loadLevelByIndex(key, rules));
+        return level;
+    });
+    m_slots.append(slot);
+}
+
+std::optional<LevelData> LevelPreloader::take(int key, const GameRules& rules)
+{
+    const qsizetype index = findSlot(key, rules);
+    if (index < 0)
+        return std::nullopt;
+
+    QFuture<std::shared_ptr<LevelData>> future = m_slots.at(index).future;
+    m_slots.removeAt(index);
+
+    // Очікування заморозило б меню на весь час читання великого рівня; завдання
+    // доробиться у пулі потоків, а його результат просто відкинеться.
+    if (!future.isFinished())
+        return std::nullopt;
+    const std::shared_ptr<LevelData> level = future.result();
+    if (!level || !level->map)
+        return std::nullopt;
+    return std::move(*level);
+}
+
+void LevelPreloader::clear()
+{
+    // Незавершені завдання доробляться у пулі потоків, їхні результати просто відкинуться.
+    m_slots.clear();
+}
+
+qsizetype LevelPreloader::findSlot(int key, const GameRules& rules) const
+{
+    for (qsizetype i = 0; i < m_slots.size(); ++i) {
+        const Slot& slot = m_slots.at(i);
+        if (slot.key == key && slot.mapSize == rules.mapSize() && slot.baseCell == rules.baseCell()
+            && slot.persistentWorld == rules.persistentWorld())
+            return i;
+    }
+    return -1;
+}
@@ -0,0 +1,52 @@
+#ifndef LEVELPRELOADER_H
+#define LEVELPRELOADER_H
+
+#include <QFuture>
+#include <QPoint>
+#include <QSize>
+#include <QVector>
+#include <memory>
+#include <optional>
+
+#include "core/GameRules.h"
+#include "world/LevelLoader.h"
+
+/*
+ * LevelPreloader готує LevelData у робочому потоці (QtConcurrent), поки гравець
+ * у меню: для підсвіченого рівня та наступного рівня кампанії. Готові, але ще не
+ * використані результати кешуються; take() віддає карту без файлового вводу-виводу
+ * на GUI-потоці. Ключ — індекс рівня або kSavedLevel для збереженого Demo.txt
+ * разом із правилами, від яких залежить завантажена карта.
+ */
+class LevelPreloader
+{
+public:
+    static constexpr int kSavedLevel = -1;
+
+    LevelPreloader() = default;
+    ~LevelPreloader();
+    LevelPreloader(const LevelPreloader&) = delete;
+    LevelPreloader& operator=(const LevelPreloader&) = delete;
+
+    void request(int key, const GameRules& rules);
+    // Готовий рівень для ключа. Незавершене завантаження не блокує GUI-потік:
+    // слот відкидається, і викликач завантажує рівень сам.
+    std::optional<LevelData> take(int key, const GameRules& rules);
+    void clear();
+
+private:
+    struct Slot
+    {
+        int key = kSavedLevel;
+        QSize mapSize;
+        QPoint baseCell;
+        bool persistentWorld = false;   // потокова карта відкривається на запис лише для постійного світу
+        QFuture<std::shared_ptr<LevelData>> future;
+    };
+
+    qsizetype findSlot(int key, const GameRules& rules) const;
+
+    QVector<Slot> m_slots;
+};
+
+#endif // LEVELPRELOADER_H
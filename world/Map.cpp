@@ -1,11 +1,83 @@
 #include "world/Map.h"
 
+#include <QElapsedTimer>
+#include <algorithm>
+#include <utility>
+
+#include "world/MapChunkStore.h"
+
+namespace {
+bool sameTile(const Tile& lhs, const Tile& rhs)
+{
+    return lhs.type == rhs.type
+        && lhs.blockMask == rhs.blockMask
+        && lhs.destructible == rhs.destructible
+        && lhs.walkable == rhs.walkable
+        && lhs.pierceable == rhs.pierceable
+        && lhs.reinforcedMaxDamage == rhs.reinforcedMaxDamage
+        && lhs.damage() == rhs.damage();
+}
+
+// Прототипи за значенням TileType: копіювання готового Tile замість фабрики на клітинку.
+const Tile& prototypeFor(quint8 code)
+{
+    static const Tile kPrototypes[] = {
+        TileFactory::forType(TileType::Empty),
+        TileFactory::forType(TileType::Brick),
+        TileFactory::forType(TileType::Steel),
+        TileFactory::forType(TileType::Base),
+        TileFactory::forType(TileType::Forest),
+        TileFactory::forType(TileType::Water),
+        TileFactory::forType(TileType::Ice),
+    };
+    constexpr quint8 kPrototypeCount = static_cast<quint8>(sizeof(kPrototypes) / sizeof(kPrototypes[0]));
+    return kPrototypes[code < kPrototypeCount ? code : 0];
+}
+} // namespace
+
 Map::Map(int width, int height)
     : m_size(width, height),
       m_width(static_cast<qsizetype>(width)),
       m_height(static_cast<qsizetype>(height)),
-      m_tiles(m_height, QVector<Tile>(m_width, TileFactory::empty()))
+      m_chunksX((qMax(0, width) + kChunkMask) >> kChunkShift)
+{
+    // Нова карта — суцільна порожнеча: жодного масиву клітинок, лише однорідні чанки.
+    const qsizetype chunksY = (qMax(0, height) + kChunkMask) >> kChunkShift;
+    m_chunks.fill(Chunk{TileFactory::empty(), {}}, m_chunksX * chunksY);
+    m_regions.reset(m_size);
+}
+
+Map::Map(const Map& other)
+    : m_size(other.m_size),
+      m_width(other.m_width),
+      m_height(other.m_height),
+      m_chunksX(other.m_chunksX),
+      m_revision(other.m_revision),
+      m_changeLog(other.m_changeLog),
+      m_changeLogStart(other.m_changeLogStart),
+      m_chunks(other.m_chunks),
+      m_chunkState(other.m_chunkState),
+      m_residentList(other.m_residentList),
+      m_pagingStats(other.m_pagingStats),
+      m_store(other.m_store),
+      m_retainStep(other.m_retainStep),
+      m_residentBudget(other.m_residentBudget)
+{
+    // Області зв'язності не копіюються: гілка, яка їх не запитує, не платить за масив на всю карту.
+    m_regions.reset(m_size);
+}
+
+Map::~Map()
 {
+    // Власник, що зникає раніше за клони, передає зміни сховищу: воно запише їх у файл,
+    // коли зникне останній клон, а доти клони підвантажують чанки з незмінного файлу.
+    if (m_ownsStore)
+        writeDirtyChunks();
+}
+
+std::unique_ptr<Map> Map::clone() const
+{
+    return std::unique_ptr<Map>(new Map(*this));
 }
 
 bool Map::isInside(const QPoint& cell) const
@@ -25,9 +97,7 @@ Tile Map::tile(const QPoint& cell) const
     if (!isInside(cell))
         return TileFactory::steel();
 
-    const qsizetype x = static_cast<qsizetype>(cell.x());
-    const qsizetype y = static_cast<qsizetype>(cell.y());
-    return m_tiles.at(y).at(x);
+    return cellAt(cell.x(), cell.y());
 }
 
 Tile& Map::tileRef(const QPoint& cell)
@@ -37,9 +107,22 @@ Tile& Map::tileRef(const QPoint& cell)
         return outOfBounds;
     }
 
-    const qsizetype x = static_cast<qsizetype>(cell.x());
-    const qsizetype y = static_cast<qsizetype>(cell.y());
-    return m_tiles[y][x];
+    return mutableCellAt(cell.x(), cell.y());
+}
+
+Tile& Map::mutableCellAt(int x, int y)
+{
+    const qsizetype index = chunkIndex(x, y);
+    if (!m_chunkState.isEmpty() && !m_chunkState.at(index).resident)
+        pageIn(index);
+
+    // Перший запис в однорідний чанк розгортає його в повний масив клітинок.
+    Chunk& chunk = m_chunks[index];
+    if (chunk.cells.isEmpty())
+        chunk.cells.fill(chunk.uniform, kChunkCells);
+    if (m_store)
+        m_chunkState[index].dirty = true;
+    return chunk.cells[localIndex(x, y)];
 }
 
 void Map::setTile(const QPoint& cell, const Tile& tile)
@@ -47,15 +130,328 @@ void Map::setTile(const QPoint& cell, const Tile& tile)
     if (!isInside(cell))
         return;
 
-    const qsizetype x = static_cast<qsizetype>(cell.x());
-    const qsizetype y = static_cast<qsizetype>(cell.y());
-    m_tiles[y][x] = tile;
+    // Запис значення, яке однорідний чанк і так містить, не розгортає його.
+    const bool sameAsUniform = sameTile(cellAt(cell.x(), cell.y()), tile)
+        && m_chunks.at(chunkIndex(cell.x(), cell.y())).cells.isEmpty();
+    if (!sameAsUniform)
+        mutableCellAt(cell.x(), cell.y()) = tile;
+    m_regions.setWalkable(cell, !(tile.blockMask & BlockTank));
+    ++m_revision;
+    if (m_changeLog.isEmpty())
+        m_changeLog.resize(kChangeLogSize);
+    m_changeLog[static_cast<qsizetype>(m_revision % kChangeLogSize)] = cell;
+}
+
+bool Map::changesSince(quint64 revision, QVector<QPoint>& cells) const
+{
+    if (revision < m_changeLogStart || revision > m_revision || m_revision - revision > kChangeLogSize)
+        return false;
+
+    cells.clear();
+    for (quint64 r = revision + 1; r <= m_revision; ++r)
+        cells.append(m_changeLog.at(static_cast<qsizetype>(r % kChangeLogSize)));
+    return true;
+}
+
+bool Map::assignTileTypes(QByteArrayView types)
+{
+    if (types.size() != m_width * m_height)
+        return false;
+
+    const auto* codes = reinterpret_cast<const quint8*>(types.data());
+    for (qsizetype i = 0; i < m_chunks.size(); ++i)
+        loadChunk(m_chunks[i], i, codes);
+    if (m_store) {
+        m_chunkState.fill(ChunkState{m_retainStep, true, true}, m_chunks.size());
+        m_residentList.resize(m_chunks.size());
+        for (qsizetype i = 0; i < m_chunks.size(); ++i)
+            m_residentList[i] = i;
+        m_pagingStats.residentChunks = static_cast<int>(m_chunks.size());
+    }
+
+    m_regions.markDirty();
+    ++m_revision;
+    m_changeLogStart = m_revision;
+    return true;
+}
+
+QRect Map::chunkRect(qsizetype index) const
+{
+    const int x0 = static_cast<int>(index % m_chunksX) << kChunkShift;
+    const int y0 = static_cast<int>(index / m_chunksX) << kChunkShift;
+    return QRect(x0, y0, qMin(kChunkSize, m_size.width() - x0), qMin(kChunkSize, m_size.height() - y0));
+}
+
+void Map::loadChunk(Chunk& chunk, qsizetype index, const quint8* codes) const
+{
+    const QRect rect = chunkRect(index);
+
+    // Однорідний фрагмент зберігається одним значенням.
+    const quint8 first = codes[static_cast<qsizetype>(rect.top()) * m_width + rect.left()];
+    bool uniform = true;
+    for (int y = rect.top(); y <= rect.bottom() && uniform; ++y) {
+        const quint8* row = codes + static_cast<qsizetype>(y) * m_width;
+        for (int x = rect.left(); x <= rect.right(); ++x) {
+            if (row[x] != first) {
+                uniform = false;
+                break;
+            }
+        }
+    }
+
+    chunk.uniform = prototypeFor(first);
+    if (uniform) {
+        chunk.cells = QVector<Tile>();
+        return;
+    }
+
+    chunk.cells.fill(chunk.uniform, kChunkCells);
+    for (int y = rect.top(); y <= rect.bottom(); ++y) {
+        const quint8* row = codes + static_cast<qsizetype>(y) * m_width;
+        for (int x = rect.left(); x <= rect.right(); ++x)
+            chunk.cells[localIndex(x, y)] = prototypeFor(row[x]);
+    }
+}
+
+bool Map::attachStore(std::unique_ptr<MapChunkStore> store)
+{
+    if (!store || store->header().size != m_size)
+        return false;
+
+    flush();
+    m_store = std::move(store);
+    m_ownsStore = true;
+    for (Chunk& chunk : m_chunks) {
+        chunk.uniform = TileFactory::empty();
+        chunk.cells = QVector<Tile>();
+    }
+    m_chunkState.fill(ChunkState(), m_chunks.size());
+    m_residentList.clear();
+    m_pagingStats = MapStorageStats();
+    m_regions.markDirty();
+    ++m_revision;
+    m_changeLogStart = m_revision;
+    return true;
+}
+
+void Map::pageIn(qsizetype index) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Усі, хто ділить таблицю, читають той самий незмінний файл (власник не пише в нього,
+    // поки живі клони), тож чанк заповнюється на місці й таблиця не відокремлюється.
+    // Інший екземпляр, для якого чанк не завантажений, цих даних не читає.
+    loadChunk(const_cast<Chunk&>(m_chunks.at(index)), index, m_store->tiles());
+    ChunkState& state = m_chunkState[index];
+    state.resident = true;
+    state.dirty = false;
+    state.lastUsed = m_retainStep;
+    m_residentList.append(index);
+
+    const qint64 elapsed = timer.nsecsElapsed();
+    ++m_pagingStats.residentChunks;
+    ++m_pagingStats.pageIns;
+    m_pagingStats.pageInNsTotal += elapsed;
+    m_pagingStats.pageInNsMax = qMax(m_pagingStats.pageInNsMax, elapsed);
+}
+
+void Map::writeBack(qsizetype index)
+{
+    // У файл потрапляє лише TileType: часткові пошкодження цегли після вивантаження скидаються.
+    const Chunk& chunk = m_chunks.at(index);
+    const QRect rect = chunkRect(index);
+    const bool direct = canWriteBack();
+    quint8 row[kChunkSize];
+    for (int y = rect.top(); y <= rect.bottom(); ++y) {
+        for (int x = rect.left(); x <= rect.right(); ++x) {
+            const Tile& tile = chunk.cells.isEmpty() ? chunk.uniform : chunk.cells.at(localIndex(x, y));
+            row[x - rect.left()] = static_cast<quint8>(tile.type);
+        }
+        const qsizetype offset = static_cast<qsizetype>(y) * m_width + rect.left();
+        if (direct)
+            m_store->writeTiles(offset, row, rect.width());
+        else
+            m_store->deferTiles(offset, row, rect.width());
+    }
+    m_chunkState[index].dirty = false;
+    ++m_pagingStats.writeBacks;
+}
+
+void Map::retainAreas(const QVector<QRect>& areas)
+{
+    if (!m_store)
+        return;
+
+    ++m_retainStep;
+    const QRect bounds(QPoint(0, 0), m_size);
+    for (const QRect& area : areas) {
+        const QRect clipped = area.intersected(bounds);
+        if (clipped.isEmpty())
+            continue;
+        for (int cy = clipped.top() >> kChunkShift; cy <= clipped.bottom() >> kChunkShift; ++cy) {
+            for (int cx = clipped.left() >> kChunkShift; cx <= clipped.right() >> kChunkShift; ++cx) {
+                const qsizetype index = static_cast<qsizetype>(cy) * m_chunksX + cx;
+                if (!m_chunkState.at(index).resident)
+                    pageIn(index);
+                m_chunkState[index].lastUsed = m_retainStep;
+            }
+        }
+    }
+
+    qsizetype excess = m_residentList.size() - m_residentBudget;
+    if (excess <= 0)
+        return;
+
+    // Вивантажуються найдавніше потрібні чанки; змінені без права запису лишаються в пам'яті.
+    std::sort(m_residentList.begin(), m_residentList.end(), [this](qsizetype lhs, qsizetype rhs) {
+        return m_chunkState.at(lhs).lastUsed < m_chunkState.at(rhs).lastUsed;
+    });
+    QVector<qsizetype> kept;
+    kept.reserve(m_residentBudget);
+    for (const qsizetype index : std::as_const(m_residentList)) {
+        const ChunkState& state = m_chunkState.at(index);
+        if (excess <= 0 || state.lastUsed == m_retainStep || (state.dirty && !canWriteBack())) {
+            kept.append(index);
+            continue;
+        }
+        if (state.dirty)
+            writeBack(index);
+        evict(index);
+        --excess;
+    }
+    m_residentList = kept;
+}
+
+void Map::evict(qsizetype index)
+{
+    // Однорідний порожній чанк звільняє масив клітинок; інші власники таблиці зберігають свою копію.
+    Chunk& chunk = m_chunks[index];
+    chunk.uniform = TileFactory::empty();
+    chunk.cells = QVector<Tile>();
+    m_chunkState[index].resident = false;
+    --m_pagingStats.residentChunks;
+}
+
+bool Map::canWriteBack() const
+{
+    return m_ownsStore && m_store->isWritable() && m_store.use_count() == 1;
+}
+
+void Map::flush()
+{
+    if (m_store && canWriteBack())
+        writeDirtyChunks();
+}
+
+void Map::writeDirtyChunks()
+{
+    if (!m_store->isWritable())
+        return;
+
+    for (const qsizetype index : std::as_const(m_residentList)) {
+        if (m_chunkState.at(index).dirty)
+            writeBack(index);
+    }
+    m_store->flush();
+}
+
+void Map::compact()
+{
+    for (qsizetype i = 0; i < m_chunks.size(); ++i) {
+        // Читання через at(), щоби не відокремлювати спільну з клонами таблицю без потреби.
+        const Chunk& chunk = m_chunks.at(i);
+        if (chunk.cells.isEmpty())
+            continue;
+
+        const QRect rect = chunkRect(i);
+        const Tile& first = chunk.cells.at(localIndex(rect.left(), rect.top()));
+        bool uniform = true;
+        for (int y = rect.top(); y <= rect.bottom() && uniform; ++y) {
+            for (int x = rect.left(); x <= rect.right(); ++x) {
+                if (!sameTile(chunk.cells.at(localIndex(x, y)), first)) {
+                    uniform = false;
+                    break;
+                }
+            }
+        }
+
+        if (uniform) {
+            const Tile value = first;
+            Chunk& target = m_chunks[i];
+            target.uniform = value;
+            target.cells = QVector<Tile>();
+        }
+    }
+}
+
+MapStorageStats Map::storageStats() const
+{
+    MapStorageStats stats = m_pagingStats;
+    stats.chunkCount = static_cast<int>(m_chunks.size());
+    for (const Chunk& chunk : std::as_const(m_chunks)) {
+        if (!chunk.cells.isEmpty())
+            ++stats.denseChunks;
+    }
+    if (!m_store)
+        stats.residentChunks = stats.chunkCount;
+    stats.bytes = static_cast<qsizetype>(sizeof(Chunk)) * m_chunks.size()
+        + static_cast<qsizetype>(sizeof(Tile)) * kChunkCells * stats.denseChunks;
+    return stats;
+}
+
+const WalkableRegions& Map::regions() const
+{
+    if (m_regions.isDirty())
+        m_regions.rebuild(*this);
+    return m_regions;
 }
 
 bool Map::isWalkable(const QPoint& cell) const
 {
     // Рух танків обмежується лише маскою BlockTank.
     // Таким чином дані карти вирішують, які клітинки є стінами, без гілок у коді руху.
-    const Tile target = tile(cell);
-    return !(target.blockMask & BlockTank);
+    if (!isInside(cell))
+        return false;
+    return !(cellAt(cell.x(), cell.y()).blockMask & BlockTank);
+}
+
+BulletRayHit Map::castBulletRay(const QPoint& origin, const QPoint& step, bool canPierceSteel, int maxDistance) const
+{
+    BulletRayHit hit;
+    hit.cell = origin;
+
+    if (step.isNull())
+        return hit;
+
+    const int limit = maxDistance >= 0 ? maxDistance : static_cast<int>(qMax(m_width, m_height));
+    QPoint cell = origin;
+    for (int distance = 0; distance <= limit; ++distance, cell += step) {
+        if (!isInside(cell)) {
+            hit.cell = cell;
+            hit.distance = distance;
+            hit.blocked = true;
+            hit.inside = false;
+            return hit;
+        }
+
+        // читаємо тайл за константним посиланням, без копії та перевірок tile()
+        const Tile& target = cellAt(cell.x(), cell.y());
+        if (!(target.blockMask & BlockBullet))
+            continue;
+        if (canPierceSteel && target.pierceable)
+            continue;
+
+        hit.cell = cell;
+        hit.distance = distance;
+        hit.type = target.type;
+        hit.blocked = true;
+        hit.inside = true;
+        return hit;
+    }
+
+    hit.cell = cell;
+    hit.distance = limit + 1;
+    hit.inside = isInside(cell);
+    return hit;
 }
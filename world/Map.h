@@ -1,35 +1,171 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include <QByteArrayView>
 #include <QPoint>
+#include <QRect>
 #include <QSize>
 #include <QVector>
 #include <QtGlobal>
+#include <memory>
 
 #include "world/Tile.h"
+#include "world/WalkableRegions.h"
+
+class MapChunkStore;
+
+// Результат трасування снаряду вздовж осі: перша клітинка, що зупинить кулю.
+struct BulletRayHit
+{
+    QPoint cell;            // клітинка зупинки (може лежати поза картою)
+    int distance = 0;       // кількість вільних клітинок від початку променя до зупинки
+    TileType type = TileType::Steel;
+    bool blocked = false;   // false — промінь вичерпав maxDistance без перешкоди
+    bool inside = false;    // false — куля вилетить за межі карти
+};
+
+struct MapStorageStats
+{
+    int chunkCount = 0;
+    int denseChunks = 0;        // чанки з власним масивом 32×32
+    qsizetype bytes = 0;        // приблизний обсяг сховища тайлів
+    // Потокова карта: скільки чанків у пам'яті та скільки коштує їх підвантаження.
+    int residentChunks = 0;
+    quint64 pageIns = 0;
+    quint64 writeBacks = 0;     // змінені чанки, записані назад у файл при вивантаженні
+    qint64 pageInNsTotal = 0;
+    qint64 pageInNsMax = 0;
+};
 
 /*
  * Map зберігає сітку Tile та допоміжні методи
  * для колізій і модифікації клітинок.
+ * Сховище розбите на чанки 32×32: однорідний чанк (порожнеча, сталева рамка)
+ * тримає одне значення Tile, а масив клітинок з'являється лише при першій
+ * зміні всередині нього. Тож арена 4096×4096 займає кілька мегабайтів.
+ * Потокова карта (attachStore) бере чанки з відображеного файлу при першому
+ * зверненні, а retainAreas тримає робочу множину навколо танків і вивантажує
+ * решту понад бюджет. Змінені чанки записуються назад у файл лише для сховища,
+ * відкритого на запис (постійний світ), інакше лишаються в пам'яті.
+ * У межах робочої множини лишаються відтворення (клітинки камери), пошук бонусу
+ * і планувальник ворогів; знімок SimState для EnemyCommander і regions() досі
+ * читають усю карту.
+ * Таблиця чанків і масиви клітинок неявно спільні (копіювання під час запису),
+ * тож clone() коштує O(1), а гілка пошуку чи перемотки копіює лише ті чанки,
+ * які змінює через setTile/tileRef.
  */
 class Map
 {
 public:
     Map(int width, int height);
     explicit Map(const QSize& size) : Map(size.width(), size.height()) {}
+    ~Map();
+    Map& operator=(const Map&) = delete;
+
+    // Незалежна копія, що ділить з оригіналом усі чанки до першої зміни.
+    // Клон потокової карти читає той самий файл, але ніколи в нього не пише.
+    std::unique_ptr<Map> clone() const;
 
     QSize size() const { return m_size; }
+    // Лічильник змін setTile: кеші, що залежать від прохідності, порівнюють його замість повного перерахунку.
+    quint64 revision() const { return m_revision; }
+    // Клітинки, змінені setTile після revision, по одній на зміну. false — журнал
+    // (останні kChangeLogSize змін) не сягає так далеко або карту перезаписано цілком.
+    bool changesSince(quint64 revision, QVector<QPoint>& cells) const;
     bool isInside(const QPoint& cell) const;
     Tile tile(const QPoint& cell) const;
     Tile& tileRef(const QPoint& cell);
     void setTile(const QPoint& cell, const Tile& tile);
+    // Заповнює всю карту з масиву кодів TileType (рядок за рядком) без розбору тексту.
+    // false — розмір масиву не збігається з картою.
+    bool assignTileTypes(QByteArrayView types);
     bool isWalkable(const QPoint& cell) const;
+    // Області зв'язності прохідних клітинок, оновлювані разом із setTile.
+    // Перша побудова читає всю карту, тож для потокової карти підвантажує всі чанки.
+    const WalkableRegions& regions() const;
+    MapStorageStats storageStats() const;
+    // Повертає до однорідного вигляду чанки, де всі клітинки знову однакові.
+    void compact();
+
+    // Переводить карту на потокове читання з файлу того ж розміру: всі чанки стають невантаженими.
+    bool attachStore(std::unique_ptr<MapChunkStore> store);
+    bool isStreamed() const { return m_store != nullptr; }
+    void setResidentChunkBudget(int chunks) { m_residentBudget = qMax(1, chunks); }
+    // Підвантажує чанки, що перетинають areas (у клітинках), і вивантажує найдавніші поза ними.
+    void retainAreas(const QVector<QRect>& areas);
+    // Записує змінені чанки у файл, не вивантажуючи їх. Поки живі клони, запис
+    // відкладається, щоб їм не підмінили ще не завантажені чанки.
+    void flush();
+
+    // Осьовий промінь з origin кроком step (одинична вісь) за правилами CollisionSystem:
+    // зупиняє лише маска BlockBullet, а сталь пропускається, якщо куля її пробиває.
+    // maxDistance < 0 — до краю карти.
+    BulletRayHit castBulletRay(const QPoint& origin, const QPoint& step, bool canPierceSteel, int maxDistance = -1) const;
 
 private:
+    Map(const Map& other);
+
+    static constexpr int kChunkShift = 5;
+    static constexpr int kChunkSize = 1 << kChunkShift;
+    static constexpr int kChunkMask = kChunkSize - 1;
+    static constexpr int kChunkCells = kChunkSize * kChunkSize;
+    static constexpr int kDefaultResidentChunks = 4096;
+    static constexpr int kChangeLogSize = 256;
+
+    struct Chunk
+    {
+        Tile uniform;               // значення всіх клітинок, поки cells порожній
+        QVector<Tile> cells;        // kChunkCells клітинок після першої неоднорідної зміни
+    };
+
+    // Стан чанка потокової карти — свій у кожного екземпляра, щоби читання й облік
+    // робочої множини не відокремлювали спільну з клонами таблицю m_chunks.
+    struct ChunkState
+    {
+        quint32 lastUsed = 0;       // крок retainAreas, коли чанк востаннє був потрібен
+        bool resident = false;      // false — дані лишились у файлі
+        bool dirty = false;         // змінений після підвантаження, ще не записаний у файл
+    };
+
+    qsizetype chunkIndex(int x, int y) const { return (y >> kChunkShift) * m_chunksX + (x >> kChunkShift); }
+    static int localIndex(int x, int y) { return ((y & kChunkMask) << kChunkShift) | (x & kChunkMask); }
+    // Клітинка всередині карти без перевірки меж: дві адресації й одна гілка однорідності.
+    const Tile& cellAt(int x, int y) const
+    {
+        const qsizetype index = chunkIndex(x, y);
+        if (!m_chunkState.isEmpty() && !m_chunkState.at(index).resident)
+            pageIn(index);
+        const Chunk& chunk = m_chunks.at(index);
+        return chunk.cells.isEmpty() ? chunk.uniform : chunk.cells.at(localIndex(x, y));
+    }
+    Tile& mutableCellAt(int x, int y);
+    QRect chunkRect(qsizetype index) const;
+    // Заповнює чанк з масиву кодів TileType шириною m_width; однорідний лишається одним значенням.
+    void loadChunk(Chunk& chunk, qsizetype index, const quint8* codes) const;
+    // Вивантажує чанк лише в цьому екземплярі; спільна таблиця відокремлюється, бо це запис.
+    void evict(qsizetype index);
+    void pageIn(qsizetype index) const;
+    void writeBack(qsizetype index);
+    bool canWriteBack() const;
+    void writeDirtyChunks();
+
     QSize m_size;
     qsizetype m_width = 0;
     qsizetype m_height = 0;
-    QVector<QVector<Tile>> m_tiles; // m_tiles[y][x]
+    qsizetype m_chunksX = 0;
+    quint64 m_revision = 0;
+    QVector<QPoint> m_changeLog;        // кільце: клітинка зміни r — у m_changeLog[r % kChangeLogSize]
+    quint64 m_changeLogStart = 0;       // ревізія останнього перезапису всієї карти
+    QVector<Chunk> m_chunks;            // m_chunks[(y / 32) * m_chunksX + x / 32], спільна з клонами
+    // Мутабельні, бо потокова карта підвантажує чанки з const-запитів.
+    mutable QVector<ChunkState> m_chunkState;   // порожній, поки карта не потокова
+    mutable QVector<qsizetype> m_residentList;
+    mutable MapStorageStats m_pagingStats;
+    mutable WalkableRegions m_regions;
+    std::shared_ptr<MapChunkStore> m_store;   // спільний з клонами
+    bool m_ownsStore = false;                 // лише оригінал записує зміни у файл
+    quint32 m_retainStep = 0;
+    int m_residentBudget = kDefaultResidentChunks;
 };
 
 #endif // MAP_H
@@ -0,0 +1,92 @@
+#include "world/MapChunkStore.h"
+
+#include <cstring>
+
+namespace {
+bool fail(QString* error, const QString& message)
+{
+    if (error)
+        *error = message;
+    return false;
+}
+} // namespace
+
+MapChunkStore::~MapChunkStore()
+{
+    close();
+}
+
+bool MapChunkStore::open(const QString& filePath, bool writable, QString* error)
+{
+    close();
+    m_file.setFileName(filePath);
+    m_writable = writable && m_file.open(QIODevice::ReadWrite);
+    if (!m_writable && !m_file.open(QIODevice::ReadOnly))
+        return fail(error, m_file.errorString());
+
+    const qint64 size = m_file.size();
+    if (size > 0)
+        m_mapped = m_file.map(0, size);
+    if (!m_mapped) {
+        close();
+        return fail(error, QStringLiteral("file cannot be memory-mapped"));
+    }
+    m_mappedSize = static_cast<qsizetype>(size);
+
+    const QByteArrayView data(m_mapped, m_mappedSize);
+    if (!BinaryLevelCodec::readHeader(data, m_header, error)) {
+        close();
+        return false;
+    }
+    // RLE не дає адресувати рядок напряму, тож стиснені рівні завантажуються цілком.
+    if (m_header.flags & BinaryLevelCodec::RunLengthEncoded) {
+        close();
+        return fail(error, QStringLiteral("compressed levels cannot be streamed"));
+    }
+    return true;
+}
+
+void MapChunkStore::writeTiles(qsizetype offset, const quint8* codes, qsizetype count)
+{
+    if (!m_writable)
+        return;
+
+    uchar* target = m_mapped + m_header.payloadOffset + offset;
+    if (memcmp(target, codes, static_cast<size_t>(count)) == 0)
+        return;
+    memcpy(target, codes, static_cast<size_t>(count));
+    m_modified = true;
+}
+
+void MapChunkStore::deferTiles(qsizetype offset, const quint8* codes, qsizetype count)
+{
+    if (!m_writable)
+        return;
+    m_deferred.insert(offset, QByteArray(reinterpret_cast<const char*>(codes), count));
+}
+
+void MapChunkStore::flush()
+{
+    // Повний прохід для контрольної суми — лише коли файл справді змінено.
+    if (!m_modified)
+        return;
+    BinaryLevelCodec::updateChecksum(reinterpret_cast<char*>(m_mapped), m_mappedSize);
+    m_modified = false;
+}
+
+void MapChunkStore::close()
+{
+    if (m_mapped) {
+        for (auto it = m_deferred.cbegin(); it != m_deferred.cend(); ++it)
+            writeTiles(it.key(), reinterpret_cast<const quint8*>(it.value().constData()), it.value().size());
+        flush();
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    m_file.close();
+    m_mappedSize = 0;
+    m_header = BinaryLevelHeader();
+    m_deferred.clear();
+    m_writable = false;
+    m_modified = false;
+}
@@ -0,0 +1,53 @@
+#ifndef MAPCHUNKSTORE_H
+#define MAPCHUNKSTORE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QtGlobal>
+
+#include "world/BinaryLevelCodec.h"
+
+/*
+ * MapChunkStore — відображений у пам'ять нестиснений файл *.gslv, з якого Map
+ * підвантажує чанки на вимогу. За замовчуванням файл відкривається лише для
+ * читання, і карта тримає змінені чанки в пам'яті. З writable (постійний світ)
+ * змінені чанки (зруйнована цегла) записуються прямо у відображення, а контрольна
+ * сума заголовка перераховується в flush(). Контрольна сума при відкритті не
+ * перевіряється — інакше довелося б прочитати весь файл, чого потокове читання й уникає.
+ */
+class MapChunkStore
+{
+public:
+    MapChunkStore() = default;
+    ~MapChunkStore();
+    MapChunkStore(const MapChunkStore&) = delete;
+    MapChunkStore& operator=(const MapChunkStore&) = delete;
+
+    // writable — спробувати відкрити для запису; якщо ОС не дозволяє, файл лишається лише для читання.
+    bool open(const QString& filePath, bool writable = false, QString* error = nullptr);
+    const BinaryLevelHeader& header() const { return m_header; }
+    bool isWritable() const { return m_writable; }
+
+    // Значення TileType по рядках шириною header().size.width().
+    const quint8* tiles() const { return m_mapped + m_header.payloadOffset; }
+    void writeTiles(qsizetype offset, const quint8* codes, qsizetype count);
+    // Запис, відкладений до закриття: власник карти зникає, поки клони ще читають
+    // файл, і ті мусять бачити його незмінним. Закриття робить останній утримувач.
+    void deferTiles(qsizetype offset, const quint8* codes, qsizetype count);
+    void flush();
+
+private:
+    void close();
+
+    QFile m_file;
+    uchar* m_mapped = nullptr;
+    qsizetype m_mappedSize = 0;
+    BinaryLevelHeader m_header;
+    QHash<qsizetype, QByteArray> m_deferred;   // зміщення в масиві тайлів → коди
+    bool m_writable = false;
+    bool m_modified = false;
+};
+
+#endif // MAPCHUNKSTORE_H
@@ -0,0 +1,57 @@
+#include "world/OccupancyGrid.h"
+
+void OccupancyGrid::resize(const QSize& size)
+{
+    m_size = size;
+    const qsizetype cellCount = size.isEmpty() ? 0 : static_cast<qsizetype>(size.width()) * size.height();
+    m_cells.fill(nullptr, cellCount);
+}
+
+void OccupancyGrid::clear()
+{
+    m_cells.fill(nullptr);
+}
+
+const Tank* OccupancyGrid::occupant(const QPoint& cell) const
+{
+    const qsizetype index = indexOf(cell);
+    return index >= 0 ? m_cells.at(index) : nullptr;
+}
+
+bool OccupancyGrid::isFreeFor(const QPoint& cell, const Tank* tank) const
+{
+    const Tank* owner = occupant(cell);
+    return !owner || owner == tank;
+}
+
+bool OccupancyGrid::claim(const QPoint& cell, const Tank* tank)
+{
+    const qsizetype index = indexOf(cell);
+    if (index < 0)
+        return true;
+
+    const Tank* owner = m_cells.at(index);
+    if (owner && owner != tank)
+        return false;
+
+    m_cells[index] = tank;
+    return true;
+}
+
+void OccupancyGrid::release(const QPoint& cell, const Tank* tank)
+{
+    const qsizetype index = indexOf(cell);
+    if (index < 0)
+        return;
+
+    if (m_cells.at(index) == tank)
+        m_cells[index] = nullptr;
+}
+
+qsizetype OccupancyGrid::indexOf(const QPoint& cell) const
+{
+    if (cell.x() < 0 || cell.y() < 0 || cell.x() >= m_size.width() || cell.y() >= m_size.height())
+        return -1;
+
+    return static_cast<qsizetype>(cell.y()) * m_size.width() + cell.x();
+}
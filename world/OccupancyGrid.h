@@ -0,0 +1,37 @@
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include <QPoint>
+#include <QSize>
+#include <QVector>
+#include <QtGlobal>
+
+class Tank;
+
+/*
+ * OccupancyGrid — покомірковий облік танків. Танк займає свою клітинку
+ * і, під час кроку, клітинку призначення; інший танк у зайняту клітинку
+ * не заходить. Сітка плоска (y * width + x), запит і захоплення — O(1).
+ */
+class OccupancyGrid
+{
+public:
+    void resize(const QSize& size);
+    void clear();
+
+    QSize size() const { return m_size; }
+    const Tank* occupant(const QPoint& cell) const;
+    bool isFreeFor(const QPoint& cell, const Tank* tank) const;
+
+    // Повертає false, якщо клітинка вже належить іншому танку.
+    bool claim(const QPoint& cell, const Tank* tank);
+    void release(const QPoint& cell, const Tank* tank);
+
+private:
+    qsizetype indexOf(const QPoint& cell) const;
+
+    QSize m_size;
+    QVector<const Tank*> m_cells;
+};
+
+#endif // OCCUPANCYGRID_H
@@ -125,3 +125,18 @@ Tile TileFactory::ice()
     t.walkable = true;
     return t;
 }
+
+Tile TileFactory::forType(TileType type)
+{
+    switch (type) {
+    case TileType::Empty: return empty();
+    case TileType::Brick: return brick();
+    case TileType::Steel: return steel();
+    case TileType::Base: return base();
+    case TileType::Forest: return forest();
+    case TileType::Water: return water();
+    case TileType::Ice: return ice();
+    }
+
+    return empty();
+}
@@ -67,6 +67,7 @@ Tile base();
 Tile forest();
 Tile water();
 Tile ice();
+Tile forType(TileType type);
 }
 
 #endif // TILE_H
@@ -0,0 +1,125 @@
+#include "world/WalkableRegions.h"
+
+#include <utility>
+
+#include "world/Map.h"
+
+void WalkableRegions::reset(const QSize& size)
+{
+    m_size = size;
+    m_parent.clear();
+    m_rank.clear();
+    m_dirty = true;
+}
+
+void WalkableRegions::rebuild(const Map& map)
+{
+    const int width = m_size.width();
+    const int height = m_size.height();
+    const int count = qMax(0, width) * qMax(0, height);
+    m_parent.resize(count);
+    m_rank.fill(0, count);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int i = y * width + x;
+            m_parent[i] = map.isWalkable(QPoint(x, y)) ? i : kNoRegion;
+        }
+    }
+
+    // Один прохід: кожна прохідна клітинка з'єднується з правим і нижнім сусідом.
+    for (int i = 0; i < count; ++i) {
+        if (m_parent.at(i) == kNoRegion)
+            continue;
+        if ((i + 1) % width != 0 && m_parent.at(i + 1) != kNoRegion)
+            unite(i, i + 1);
+        if (i + width < count && m_parent.at(i + width) != kNoRegion)
+            unite(i, i + width);
+    }
+    m_dirty = false;
+}
+
+void WalkableRegions::setWalkable(const QPoint& cell, bool walkable)
+{
+    if (m_dirty || !isInside(cell))
+        return;
+
+    const int i = index(cell);
+    const bool wasWalkable = m_parent.at(i) != kNoRegion;
+    if (wasWalkable == walkable)
+        return;
+
+    // Нова стіна може розрізати область — union-find цього не вміє, перебудуємо при запиті.
+    if (!walkable) {
+        m_dirty = true;
+        return;
+    }
+
+    m_parent[i] = i;
+    m_rank[i] = 0;
+    const QPoint neighbours[4] = {cell + QPoint(1, 0), cell + QPoint(-1, 0), cell + QPoint(0, 1), cell + QPoint(0, -1)};
+    for (const QPoint& neighbour : neighbours) {
+        if (isInside(neighbour) && m_parent.at(index(neighbour)) != kNoRegion)
+            unite(i, index(neighbour));
+    }
+}
+
+int WalkableRegions::region(const QPoint& cell) const
+{
+    if (m_dirty || !isInside(cell))
+        return kNoRegion;
+
+    const int i = index(cell);
+    return m_parent.at(i) == kNoRegion ? kNoRegion : find(i);
+}
+
+bool WalkableRegions::connected(const QPoint& a, const QPoint& b) const
+{
+    const int regionA = region(a);
+    return regionA != kNoRegion && regionA == region(b);
+}
+
+bool WalkableRegions::reachesCell(const QPoint& from, const QPoint& target) const
+{
+    const int start = region(from);
+    if (start == kNoRegion)
+        return false;
+    if (region(target) == start)
+        return true;
+
+    const QPoint neighbours[4] = {target + QPoint(1, 0), target + QPoint(-1, 0), target + QPoint(0, 1), target + QPoint(0, -1)};
+    for (const QPoint& neighbour : neighbours) {
+        if (region(neighbour) == start)
+            return true;
+    }
+    return false;
+}
+
+int WalkableRegions::find(int index) const
+{
+    // Стиснення шляху навпіл: кожна пройдена клітинка перепідвішується до «діда».
+    while (m_parent.at(index) != index) {
+        m_parent[index] = m_parent.at(m_parent.at(index));
+        index = m_parent.at(index);
+    }
+    return index;
+}
+
+void WalkableRegions::unite(int a, int b)
+{
+    int rootA = find(a);
+    int rootB = find(b);
+    if (rootA == rootB)
+        return;
+
+    if (m_rank.at(rootA) < m_rank.at(rootB))
+        std::swap(rootA, rootB);
+    m_parent[rootB] = rootA;
+    if (m_rank.at(rootA) == m_rank.at(rootB))
+        ++m_rank[rootA];
+}
+
+bool WalkableRegions::isInside(const QPoint& cell) const
+{
+    return cell.x() >= 0 && cell.y() >= 0 && cell.x() < m_size.width() && cell.y() < m_size.height();
+}
@@ -0,0 +1,50 @@
+#ifndef WALKABLEREGIONS_H
+#define WALKABLEREGIONS_H
+
+#include <QPoint>
+#include <QSize>
+#include <QVector>
+#include <QtGlobal>
+
+class Map;
+
+/*
+ * WalkableRegions — система неперетинних множин (union-find) над прохідними
+ * клітинками карти. Map повідомляє про кожну зміну прохідності: коли цеглу
+ * зруйновано, клітинка просто зливається з сусідами за майже O(1). Розрізати
+ * union-find не вміє, тож появу нової стіни (редактор, завантаження) позначаємо
+ * як «брудний» стан і перебудовуємо все одним лінійним проходом при наступному запиті.
+ * Масиви виділяються лише при першому запиті, тож великі карти без запитів їх не тримають.
+ */
+class WalkableRegions
+{
+public:
+    static constexpr int kNoRegion = -1;
+
+    void reset(const QSize& size);
+    bool isDirty() const { return m_dirty; }
+    void markDirty() { m_dirty = true; }
+    void rebuild(const Map& map);
+    // Викликається Map при кожній зміні клітинки; поки структура брудна — нічого не робить.
+    void setWalkable(const QPoint& cell, bool walkable);
+
+    // Ідентифікатор області прохідної клітинки або kNoRegion; дійсний до наступної зміни карти.
+    int region(const QPoint& cell) const;
+    bool connected(const QPoint& a, const QPoint& b) const;
+    // Чи можна з from під'їхати впритул до target — для непрохідних цілей на кшталт бази.
+    bool reachesCell(const QPoint& from, const QPoint& target) const;
+
+private:
+    int find(int index) const;
+    void unite(int a, int b);
+    bool isInside(const QPoint& cell) const;
+    int index(const QPoint& cell) const { return cell.y() * m_size.width() + cell.x(); }
+
+    QSize m_size;
+    // kNoRegion — непрохідна клітинка; мутабельний через стиснення шляхів у const-запитах.
+    mutable QVector<int> m_parent;
+    QVector<quint8> m_rank;
+    bool m_dirty = true;
+};
+
+#endif // WALKABLEREGIONS_H